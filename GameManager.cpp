@@ -1,9 +1,14 @@
 #include "GameManager.h"
 #include "common/game_state.h"
 #include "common/GameContext.h"
+#include "common/frame_scheduler.h"
+#include "common/frame_profiler.h"
+#include "common/input_state.h"
+#include "common/input_recorder.h"
+#include "common/run_writer.h"
 #include "UI/menu.h"
 #include "UI/input.h"
-#include "UI/leaderboard.h"
+#include "UI/loading_screen.h"
 #include "floors/floor1/floor1.h"
 #include "floors/floor2/floor2.h"
 #include "floors/floor3/floor3.h"
@@ -12,44 +17,158 @@
 
 GameManager::GameManager() {}
 
-void GameManager::run(GameContext& context) {
-    GameState menuResult = runMenu(context);
-    context.nextState = menuResult;  // Record user choice
-    if (menuResult == EXIT) return;
-
-    setCurrentFloor(1); // Start game at Floor 1
-
-    while (true) {
-        // 🛑 Check if player hit "Quit" from any floor
-        if (context.nextState == MENU) {
-            menuResult = runMenu(context);
-            context.nextState = menuResult;
-            if (menuResult == EXIT) return;
-            setCurrentFloor(1);
-            continue;
-        } else if (context.nextState == EXIT) {
-            return;
-        }
+void GameManager::setRecorder(InputRecorder* inputRecorder) {
+    recorder = inputRecorder;
+}
 
-        int currentFloor = getCurrentFloor();
+void GameManager::setReplay(InputReplay* inputReplay, bool fast) {
+    replay = inputReplay;
+    fastReplay = fast;
+}
 
-        if (currentFloor == 1) {
-            runFloor1(context); // May set context.nextState = MENU
-        } 
-        else if (currentFloor == 2) {
-            runFloor2(context);
-        }
-        else if (currentFloor == 3) {
-            runFloor3(context);
-            context.nextState = MENU;
-        } 
-        else {
-            std::cout << "Unknown floor. Exiting...\n";
-            break;
+void GameManager::dispatch(const SDL_Event& e, GameContext& context) {
+    if (recorder) recorder->record(e);
+    InputState::instance().handleEvent(e);
+    if (FrameProfiler::instance().handleEvent(e)) return;
+    if (e.type == SDL_QUIT) {
+        context.nextState = EXIT;
+        return;
+    }
+    stack.handleEvent(e);
+}
+
+bool GameManager::replayFrame(FrameScheduler& frame, GameContext& context) {
+    double seconds = 0.0;
+    if (!replay->nextFrame(seconds, replayEvents)) return false;
+
+    frame.beginFrame(seconds);
+    for (const SDL_Event& e : replayEvents) dispatch(e, context);
+
+    // Live input would desync the recording; only closing the window counts
+    SDL_Event e;
+    while (SDL_PollEvent(&e)) {
+        if (e.type == SDL_QUIT) context.nextState = EXIT;
+        else FrameProfiler::instance().handleEvent(e);
+    }
+    return true;
+}
+
+void GameManager::followGameState(GameContext& context) {
+    if (context.nextState == EXIT) {
+        stack.clear();
+        return;
+    }
+
+    // 🛑 Check if player hit "Quit" from any floor
+    if (context.nextState == MENU) {
+        if (activeFloor != 0 || stack.empty()) {
+            stack.clear();
+            stack.push(createMenuScene(context));
+            activeFloor = 0;
         }
+        return;
     }
 
+    int currentFloor = getCurrentFloor();
+    if (currentFloor == activeFloor) return;
+
+    const AssetList* assets = nullptr;
+    std::unique_ptr<Scene> (*createFloor)(GameContext&) = nullptr;
+    if (currentFloor == 1) {
+        assets = &floor1Assets();
+        createFloor = createFloor1Scene;
+    } else if (currentFloor == 2) {
+        assets = &floor2Assets();
+        createFloor = createFloor2Scene;
+    } else if (currentFloor == 3) {
+        assets = &floor3Assets();
+        createFloor = createFloor3Scene;
+    } else {
+        std::cout << "Unknown floor. Exiting...\n";
+        stack.clear();
+        return;
+    }
 
+    // The floor goes on once its assets are resident. Recording and replay
+    // load synchronously so both see the floor arrive on the same frame.
+    stack.clear();
+    std::string title = "FLOOR " + std::to_string(currentFloor);
+    bool blocking = recorder || replay;
+    stack.push(std::make_unique<LoadingScene>(context.renderer, *assets, title, blocking),
+               [this, &context, createFloor](bool) { stack.push(createFloor(context)); });
+    activeFloor = currentFloor;
 }
 
+void GameManager::run(GameContext& context) {
+    SDL_Renderer* renderer = context.renderer;
+
+    context.nextState = MENU;
+    followGameState(context);
+    stack.applyPending();
+
+    FrameScheduler frame;
+    FrameProfiler& profiler = FrameProfiler::instance();
+    Uint64 replayStart = SDL_GetPerformanceCounter();
+    bool changed = true;
+    while (!stack.empty()) {
+        // Static screens sleep until input or their next redraw is due;
+        // not while the profiler graph is up, so it keeps scrolling
+        int idleMs = stack.top()->redrawIntervalMs();
+        if (!replay && !changed && idleMs > 0 && !profiler.isVisible()) FrameScheduler::waitForEvent(idleMs);
+
+        profiler.beginFrame();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        if (replay) {
+            if (!replayFrame(frame, context)) {
+                context.nextState = EXIT;
+                followGameState(context);
+                break;
+            }
+        } else {
+            frame.beginFrame();
+            if (recorder) recorder->beginFrame(frame.elapsedSeconds());
+            SDL_Event e;
+            while (SDL_PollEvent(&e)) {
+                dispatch(e, context);
+                if (context.nextState == EXIT) break;
+            }
+            if (recorder) recorder->endFrame();
+        }
+        profiler.endPhase(FrameProfiler::EVENTS);
+
+        while (frame.step()) stack.update(frame.stepSeconds());
+        profiler.endPhase(FrameProfiler::UPDATE);
+
+        if (!fastReplay) {
+            stack.render(renderer, frame.alpha());
+            profiler.draw(renderer);
+            profiler.endPhase(FrameProfiler::RENDER);
+
+            SDL_RenderPresent(renderer);
+            profiler.endPhase(FrameProfiler::PRESENT);
+        }
+
+        followGameState(context);
+        changed = stack.applyPending();
+
+        // A run written in the background may change what the menu shows
+        if (RunWriter::instance().pump()) changed = true;
+
+        if (!replay) {
+            frame.endFrame();
+        } else if (!fastReplay) {
+            // Real-time replay holds each frame for as long as it took when recorded
+            Uint64 frequency = SDL_GetPerformanceFrequency();
+            Uint64 until = frameStart + static_cast<Uint64>(frame.elapsedSeconds() * frequency);
+            for (Uint64 now = SDL_GetPerformanceCounter(); now < until; now = SDL_GetPerformanceCounter())
+                SDL_Delay(static_cast<Uint32>((until - now) * 1000 / frequency));
+        }
+        profiler.endFrame();
+    }
 
+    if (replay) {
+        double seconds = double(SDL_GetPerformanceCounter() - replayStart) / SDL_GetPerformanceFrequency();
+        std::cout << "Replay finished: " << replay->framesRead() << " frames in " << seconds << " s ("
+                  << (seconds > 0.0 ? replay->framesRead() / seconds : 0.0) << " fps)" << std::endl;
+    }
+}
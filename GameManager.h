@@ -3,15 +3,47 @@
 #define GAME_MANAGER_H
 
 #include "common/GameContext.h"
+#include "common/scene.h"
+#include <vector>
+
+class InputRecorder;
+class InputReplay;
+class FrameScheduler;
 
 // ----------------------------------------------------
-// GameManager class controls the main flow of the game
+// GameManager class controls the main flow of the game.
+// It owns the one event loop and the SceneStack every screen runs on.
 // ----------------------------------------------------
 
 class GameManager {
 public:
     GameManager();                         // Default constructor
     void run(GameContext& context);        // Starts the game loop and handles floor transitions
+
+    // Write every dispatched event to recorder (set before run())
+    void setRecorder(InputRecorder* recorder);
+
+    // Feed the game from a recording instead of the keyboard and mouse.
+    // fast runs it as quickly as the simulation allows, without rendering.
+    void setReplay(InputReplay* replay, bool fast);
+
+private:
+    // Swaps the base scene when ctx.nextState or the current floor changes
+    void followGameState(GameContext& context);
+
+    // One event through recording, input state, the profiler and the scenes
+    void dispatch(const SDL_Event& e, GameContext& context);
+
+    // Fetches this frame's events from the replay; false once it runs out
+    bool replayFrame(FrameScheduler& frame, GameContext& context);
+
+    SceneStack stack;
+    int activeFloor = -1;                  // Floor on the stack; 0 is the menu
+
+    InputRecorder* recorder = nullptr;
+    InputReplay* replay = nullptr;
+    bool fastReplay = false;
+    std::vector<SDL_Event> replayEvents;
 };
 
 #endif // GAME_MANAGER_H
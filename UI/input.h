@@ -3,9 +3,12 @@
 
 #include "GameContext.h" 
 #include <string>
+#include <memory>
 #include <SDL2/SDL_ttf.h>
+#include "scene.h"
 
-// Use this version only
-bool getPlayerName(GameContext& ctx, TTF_Font* font);
+// Asks for the player's name; finishes with true once it is entered
+// (stored in ctx.playerName), false if ESC backs out
+std::unique_ptr<Scene> createNameEntryScene(GameContext& ctx, TTF_Font* font);
 
 #endif // INPUT_H
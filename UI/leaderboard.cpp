@@ -1,127 +1,197 @@
 #include "leaderboard.h"
-#include <fstream>
-#include <sstream>
-#include <SDL2/SDL_image.h>
-
-// Helper to load image into texture
-SDL_Texture* loadTexture(const std::string& path, SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
-        std::cerr << "IMG_Load Error: " << IMG_GetError() << std::endl;
-        return nullptr;
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include "text_renderer.h"
+#include "font_registry.h"
+#include "frame_scheduler.h"
+
+static const SDL_Rect LIST_RECT = {100, 130, 600, 10 * LeaderboardScene::ROW_HEIGHT};
+static const SDL_Color TEXT_COLOR = {255, 255, 255, 255};
+static const SDL_Color BUTTON_COLOR = {70, 130, 180, 255};
+static const SDL_Color BUTTON_HOVER = {100, 180, 255, 255};
+static const int NAME_COLUMN = 110;
+static const int WHEEL_ROWS = 3;
+
+LeaderboardScene::LeaderboardScene(SDL_Renderer* renderer)
+    : renderer(renderer), backButton((720 - 200) / 2, 500, 200, 50, "MENU", BUTTON_COLOR) {}
+
+void LeaderboardScene::enter() {
+    background = TextureCache::instance().acquire(renderer, "assets/images/leaderboard_background.png");
+    titleFont = FontRegistry::instance().get("OpenSans-Bold.ttf", 36);
+    rowFont = FontRegistry::instance().get("arial.ttf", 24);
+    if (!rowFont) {
+        finish(false);
+        return;
     }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    return texture;
+    total = RunLog::instance().size();
 }
 
-void Leaderboard::loadFromFile(const std::string& filename) {
-    std::ifstream inFile(filename);
-    std::string line;
-    players.clear();
-
-    while (std::getline(inFile, line)) {
-        size_t commaPos = line.find(',');
-        if (commaPos != std::string::npos) {
-            std::string name = line.substr(0, commaPos);
-            try {
-                float time = std::stof(line.substr(commaPos + 1));
-                players.emplace_back(name, time);
-            } catch (...) {
-                std::cerr << "Invalid time entry for: " << name << "\n";
-            }
-        }
-    }
+void LeaderboardScene::exit() {
+    evictOutside(1, 0);
+    pages.clear();
 }
 
-void Leaderboard::saveToFile(const std::string& filename) {
-    std::ofstream outFile(filename);
-    for (const auto& player : players) {
-        outFile << player.name << "," << player.time << "\n";
-    }
+int LeaderboardScene::redrawIntervalMs() const {
+    return FrameScheduler::IDLE_WAKE_MS;
 }
 
-void Leaderboard::renderText(const std::string& text, int x, int y, SDL_Color color, SDL_Renderer* renderer) {
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect dst = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+void LeaderboardScene::scrollTo(int offset) {
+    int maxScroll = std::max(0, int(total) * ROW_HEIGHT - LIST_RECT.h);
+    scrollY = std::clamp(offset, 0, maxScroll);
 }
 
-bool Leaderboard::handleButtonClick(Button& button, SDL_Renderer* renderer, bool& backToMenu) {
-    int mouseX, mouseY;
-    SDL_GetMouseState(&mouseX, &mouseY);
-    SDL_Color btnColor = button.color;
-
-    bool hovered = mouseX > button.rect.x && mouseX < button.rect.x + button.rect.w &&
-                   mouseY > button.rect.y && mouseY < button.rect.y + button.rect.h;
-
-    if (hovered) {
-        btnColor = {0, 255, 255, 255};  // Cyan hover
-        button.rect.w = 250;
-        button.rect.h = 55;
-    } else {
-        button.rect.w = 220;
-        button.rect.h = 50;
+void LeaderboardScene::handleEvent(const SDL_Event& e) {
+    const int pageHeight = LIST_RECT.h - ROW_HEIGHT;
+    if (e.type == SDL_MOUSEWHEEL) {
+        scrollTo(scrollY - e.wheel.y * WHEEL_ROWS * ROW_HEIGHT);
+    } else if (e.type == SDL_KEYDOWN) {
+        switch (e.key.keysym.sym) {
+            case SDLK_UP:       scrollTo(scrollY - ROW_HEIGHT); break;
+            case SDLK_DOWN:     scrollTo(scrollY + ROW_HEIGHT); break;
+            case SDLK_PAGEUP:   scrollTo(scrollY - pageHeight); break;
+            case SDLK_PAGEDOWN: scrollTo(scrollY + pageHeight); break;
+            case SDLK_HOME:     scrollTo(0); break;
+            case SDLK_END:      scrollTo(int(total) * ROW_HEIGHT); break;
+            case SDLK_ESCAPE:   finish(); break;
+        }
+    } else if (e.type == SDL_MOUSEMOTION) {
+        SDL_Point pt = {e.motion.x, e.motion.y};
+        backButton.isHovered = SDL_PointInRect(&pt, &backButton.rect);
+    } else if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+        SDL_Point pt = {e.button.x, e.button.y};
+        if (SDL_PointInRect(&pt, &backButton.rect)) finish();
     }
+}
 
-    renderText(button.label, button.rect.x + (button.rect.w - 100) / 2, button.rect.y + (button.rect.h - 30) / 2, btnColor, renderer);
+void LeaderboardScene::update(double dt) {
+    size_t now = RunLog::instance().size();
+    if (now == total) return;
+    total = now;
+    evictOutside(1, 0);
+    scrollTo(scrollY);
+}
 
-    if (hovered && (SDL_GetMouseState(NULL, NULL) & SDL_BUTTON(SDL_BUTTON_LEFT))) {
-        if (button.label == "BACK TO MENU") backToMenu = true;
-        return true;
+// The run at rank (0 = fastest), copying its page out of RunLog on first use
+const RunRecord* LeaderboardScene::fetch(size_t rank) {
+    if (rank >= total) return nullptr;
+    size_t index = rank / PAGE_ROWS;
+    auto it = pages.find(index);
+    if (it == pages.end()) {
+        it = pages.emplace(index, std::vector<RunRecord>()).first;
+        RunLog::instance().page(index * PAGE_ROWS, PAGE_ROWS, it->second);
     }
+    size_t offset = rank % PAGE_ROWS;
+    return offset < it->second.size() ? &it->second[offset] : nullptr;
+}
 
-    return false;
+// Rank, name and time rasterized side by side into one texture
+LeaderboardScene::Row& LeaderboardScene::row(size_t rank) {
+    Row& cached = rows[rank];
+    if (cached.texture) return cached;
+
+    const RunRecord* run = fetch(rank);
+    if (!run) return cached;
+
+    char rankText[24], timeText[24];
+    std::snprintf(rankText, sizeof(rankText), "%zu.", rank + 1);
+    std::snprintf(timeText, sizeof(timeText), "%.2f", run->seconds);
+
+    SDL_Surface* parts[3] = {
+        TTF_RenderUTF8_Blended(rowFont, rankText, TEXT_COLOR),
+        run->name[0] ? TTF_RenderUTF8_Blended(rowFont, run->name, TEXT_COLOR) : nullptr,
+        TTF_RenderUTF8_Blended(rowFont, timeText, TEXT_COLOR)
+    };
+
+    SDL_Surface* line = SDL_CreateRGBSurfaceWithFormat(0, LIST_RECT.w, ROW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (line) {
+        SDL_FillRect(line, nullptr, 0);
+        int x[3] = {0, NAME_COLUMN, 0};
+        if (parts[2]) x[2] = LIST_RECT.w - parts[2]->w;
+        for (int i = 0; i < 3; ++i) {
+            if (!parts[i]) continue;
+            // Copy, not blend: the parts never overlap and the row starts transparent
+            SDL_SetSurfaceBlendMode(parts[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = {x[i], (ROW_HEIGHT - parts[i]->h) / 2, parts[i]->w, parts[i]->h};
+            SDL_BlitSurface(parts[i], nullptr, line, &dst);
+        }
+        cached.texture = SDL_CreateTextureFromSurface(renderer, line);
+        cached.w = line->w;
+        cached.h = line->h;
+        SDL_FreeSurface(line);
+    }
+    for (SDL_Surface* part : parts)
+        if (part) SDL_FreeSurface(part);
+    return cached;
 }
 
-void Leaderboard::renderLeaderboard(SDL_Renderer* renderer) {
-    SDL_Color textColor = {255, 255, 255, 255};
-    int y = 100;
+// Frees row textures and pages outside [first, last]; first > last frees all
+void LeaderboardScene::evictOutside(size_t first, size_t last) {
+    for (auto it = rows.begin(); it != rows.end();) {
+        if (first <= last && it->first >= first && it->first <= last) {
+            ++it;
+            continue;
+        }
+        if (it->second.texture) SDL_DestroyTexture(it->second.texture);
+        it = rows.erase(it);
+    }
+    for (auto it = pages.begin(); it != pages.end();) {
+        size_t pageFirst = it->first * PAGE_ROWS, pageLast = pageFirst + PAGE_ROWS - 1;
+        if (first <= last && pageLast >= first && pageFirst <= last) ++it;
+        else it = pages.erase(it);
+    }
+}
 
-    SDL_Texture* background = loadTexture("assets/images/back.png", renderer);
+void LeaderboardScene::render(SDL_Renderer* renderer, float alpha) {
+    SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
     SDL_RenderClear(renderer);
     if (background) SDL_RenderCopy(renderer, background, nullptr, nullptr);
 
-    for (const auto& player : players) {
-        std::string line = player.name + " - " + std::to_string(player.time) + " seconds";
-        renderText(line, 100, y, textColor, renderer);
-        y += 50;
+    if (titleFont) {
+        SDL_Rect r = measureText(renderer, titleFont, "LEADERBOARD");
+        drawText(renderer, titleFont, "LEADERBOARD", TEXT_COLOR, (720 - r.w) / 2, 60);
     }
 
-    Button backBtn(250, 600, 220, 50, "BACK TO MENU", {255, 0, 0, 255});
-    bool temp = false;
-    handleButtonClick(backBtn, renderer, temp);
-
-    SDL_RenderPresent(renderer);
-    if (background) SDL_DestroyTexture(background);
-}
-
-void Leaderboard::openLeaderboardWindow() {
-    SDL_Window* window = SDL_CreateWindow("Leaderboard", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 720, 720, SDL_WINDOW_SHOWN);
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    bool backToMenu = false;
-
-    while (!backToMenu) {
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                backToMenu = true;
-                break;
-            }
+    if (total == 0) {
+        SDL_Rect r = measureText(renderer, rowFont, "No escapes yet");
+        drawText(renderer, rowFont, "No escapes yet", TEXT_COLOR, (720 - r.w) / 2, LIST_RECT.y);
+    } else {
+        size_t first = size_t(scrollY / ROW_HEIGHT);
+        size_t last = std::min(total - 1, size_t((scrollY + LIST_RECT.h - 1) / ROW_HEIGHT));
+
+        // Keep a page either side warm so short scrolls reuse what is there
+        evictOutside(first >= PAGE_ROWS ? first - PAGE_ROWS : 0, last + PAGE_ROWS);
+
+        SDL_RenderSetClipRect(renderer, &LIST_RECT);
+        for (size_t rank = first; rank <= last; ++rank) {
+            Row& r = row(rank);
+            if (!r.texture) continue;
+            SDL_Rect dst = {LIST_RECT.x, LIST_RECT.y + int(rank) * ROW_HEIGHT - scrollY, r.w, r.h};
+            SDL_RenderCopy(renderer, r.texture, nullptr, &dst);
         }
-
-        Button backBtn(250, 600, 220, 50, "BACK TO MENU", {255, 0, 0, 255});
-        if (handleButtonClick(backBtn, renderer, backToMenu)) {
-            break;
+        SDL_RenderSetClipRect(renderer, nullptr);
+
+        // Scrollbar thumb sized to the share of the board in view
+        int contentHeight = int(total) * ROW_HEIGHT;
+        if (contentHeight > LIST_RECT.h) {
+            int thumbH = std::max(12, int(int64_t(LIST_RECT.h) * LIST_RECT.h / contentHeight));
+            int thumbY = LIST_RECT.y + int(int64_t(scrollY) * (LIST_RECT.h - thumbH) / (contentHeight - LIST_RECT.h));
+            SDL_Rect thumb = {LIST_RECT.x + LIST_RECT.w + 10, thumbY, 6, thumbH};
+            SDL_SetRenderDrawColor(renderer, BUTTON_HOVER.r, BUTTON_HOVER.g, BUTTON_HOVER.b, 255);
+            SDL_RenderFillRect(renderer, &thumb);
         }
 
-        renderLeaderboard(renderer);
-        SDL_Delay(16);  // ~60 FPS
+        char status[64];
+        std::snprintf(status, sizeof(status), "%zu-%zu of %zu", first + 1, last + 1, total);
+        SDL_Rect r = measureText(renderer, rowFont, status);
+        drawText(renderer, rowFont, status, TEXT_COLOR, (720 - r.w) / 2, LIST_RECT.y + LIST_RECT.h + 10);
     }
 
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
+    SDL_Color color = backButton.isHovered ? BUTTON_HOVER : backButton.color;
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+    SDL_RenderFillRect(renderer, &backButton.rect);
+    SDL_Rect labelRect = measureText(renderer, titleFont ? titleFont : rowFont, backButton.label);
+    drawText(renderer, titleFont ? titleFont : rowFont, backButton.label, TEXT_COLOR,
+             backButton.rect.x + (backButton.rect.w - labelRect.w) / 2,
+             backButton.rect.y + (backButton.rect.h - labelRect.h) / 2);
 }
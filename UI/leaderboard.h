@@ -1,42 +1,66 @@
 #ifndef LEADERBOARD_H
 #define LEADERBOARD_H
 
-#include <iostream>
-#include <vector>
-#include <string>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "button.h"
+#include "run_log.h"
+#include "scene.h"
+#include "texture_cache.h"
 
-struct Player {
-    std::string name;
-    float time;
+// ----------------------------------------------------
+// LeaderboardScene scrolls through every run in RunLog, fastest first,
+// in the main window. Only the rows in view exist as anything more than
+// a count: runs are copied out of RunLog a page at a time as the view
+// reaches them, and each visible row is rasterized once into its own
+// texture. Pages and rows well outside the view are dropped, so a board
+// of 100k runs costs about what a board of 5 does. A run RunWriter lands
+// while the board is open shifts every rank after it, so the cache is
+// dropped and rebuilt from RunLog whenever its size changes.
+//
+// Wheel, arrows, Page Up/Down and Home/End scroll; ESC or MENU leaves.
+// ----------------------------------------------------
+class LeaderboardScene : public Scene {
+public:
+    explicit LeaderboardScene(SDL_Renderer* renderer);
 
-    Player() : name(""), time(0.0f) {}
-    Player(const std::string& playerName, float completionTime)
-        : name(playerName), time(completionTime) {}
+    void enter() override;
+    void exit() override;
+    void handleEvent(const SDL_Event& e) override;
+    void update(double dt) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
 
-    // ✅ Add this for sorting
-    bool operator<(const Player& other) const {
-        return time < other.time;
-    }
-};
+    // Static until scrolled
+    int redrawIntervalMs() const override;
 
+    static const int ROW_HEIGHT = 32;
+    static const size_t PAGE_ROWS = 64;
 
-class Leaderboard
-{
-public:
-    std::vector<Player> players;
-    TTF_Font *font;
+private:
+    struct Row {
+        SDL_Texture* texture = nullptr;
+        int w = 0, h = 0;
+    };
+
+    void scrollTo(int offset);
+    const RunRecord* fetch(size_t rank);
+    Row& row(size_t rank);
+    void evictOutside(size_t first, size_t last);
 
-    Leaderboard(TTF_Font *font) : font(font) {}
+    SDL_Renderer* renderer;
+    TextureHandle background;
+    TTF_Font* titleFont = nullptr;
+    TTF_Font* rowFont = nullptr;
+    Button backButton;
 
-    void loadFromFile(const std::string &filename);
-    void saveToFile(const std::string &filename);
-    void renderLeaderboard(SDL_Renderer *renderer);
-    bool handleButtonClick(Button &button, SDL_Renderer *renderer, bool &backToMenu);
-    void renderText(const std::string &text, int x, int y, SDL_Color color, SDL_Renderer *renderer);
-    void openLeaderboardWindow();
+    size_t total = 0;
+    int scrollY = 0;  // pixels from the first row
+    std::map<size_t, std::vector<RunRecord>> pages;  // by page index
+    std::unordered_map<size_t, Row> rows;            // by rank
 };
 
-#endif
+#endif // LEADERBOARD_H
@@ -0,0 +1,51 @@
+#include "loading_screen.h"
+#include <SDL2/SDL_ttf.h>
+#include "text_renderer.h"
+#include "font_registry.h"
+
+const SDL_Color BAR_BACKGROUND = {40, 40, 60, 255};
+const SDL_Color BAR_FILL = {100, 180, 255, 255};
+const SDL_Color LOADING_TEXT_COLOR = {255, 255, 255, 255};
+
+LoadingScene::LoadingScene(SDL_Renderer* renderer, const AssetList& assets, const std::string& title,
+                           bool blocking)
+    : renderer(renderer), assets(assets), title(title), blocking(blocking) {}
+
+void LoadingScene::enter() {
+    AssetLoader& loader = AssetLoader::instance();
+    loader.queue(renderer, assets);
+    if (blocking) {
+        while (!loader.pump()) SDL_Delay(1);
+    }
+    if (loader.isIdle()) finish();
+}
+
+void LoadingScene::update(double dt) {
+    bool done = AssetLoader::instance().pump([this](int loaded, int total) {
+        progress = total > 0 ? static_cast<float>(loaded) / total : 1.0f;
+    });
+    if (done) finish();
+}
+
+void LoadingScene::render(SDL_Renderer* renderer, float alpha) {
+    int width = 0, height = 0;
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+
+    SDL_SetRenderDrawColor(renderer, 10, 10, 20, 255);
+    SDL_RenderClear(renderer);
+
+    TTF_Font* font = FontRegistry::instance().get("OpenSans-Bold.ttf", 36);
+    if (font) {
+        SDL_Rect textRect = measureText(renderer, font, title);
+        drawText(renderer, font, title, LOADING_TEXT_COLOR, (width - textRect.w) / 2, height / 2 - 60);
+    }
+
+    SDL_Rect bar = {width / 4, height / 2, width / 2, 24};
+    SDL_SetRenderDrawColor(renderer, BAR_BACKGROUND.r, BAR_BACKGROUND.g, BAR_BACKGROUND.b, 255);
+    SDL_RenderFillRect(renderer, &bar);
+
+    SDL_Rect fill = bar;
+    fill.w = static_cast<int>(bar.w * progress);
+    SDL_SetRenderDrawColor(renderer, BAR_FILL.r, BAR_FILL.g, BAR_FILL.b, 255);
+    SDL_RenderFillRect(renderer, &fill);
+}
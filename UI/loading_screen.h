@@ -0,0 +1,35 @@
+#ifndef LOADING_SCREEN_H
+#define LOADING_SCREEN_H
+
+#include <string>
+#include "scene.h"
+#include "asset_loader.h"
+
+// ----------------------------------------------------
+// LoadingScene streams assets in through AssetLoader while drawing a
+// progress bar, then finishes. If everything is already resident it
+// finishes on entry without drawing a frame.
+//
+// A blocking LoadingScene finishes all of its loading inside enter().
+// Recording and replay use it, so a load takes the same number of frames
+// (none) however fast the disk was on the day.
+// ----------------------------------------------------
+class LoadingScene : public Scene {
+public:
+    LoadingScene(SDL_Renderer* renderer, const AssetList& assets, const std::string& title,
+                 bool blocking = false);
+
+    void enter() override;
+    void handleEvent(const SDL_Event& e) override {}
+    void update(double dt) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
+
+private:
+    SDL_Renderer* renderer;
+    const AssetList& assets;
+    std::string title;
+    bool blocking;
+    float progress = 0.0f;
+};
+
+#endif // LOADING_SCREEN_H
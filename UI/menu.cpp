@@ -2,11 +2,19 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <fstream>
 #include <sstream>
 #include "input.h"
+#include "texture_cache.h"
+#include "text_renderer.h"
+#include "font_registry.h"
+#include "frame_scheduler.h"
+#include "scene.h"
+#include "asset_loader.h"
+#include "leaderboard.h"
 
 const SDL_Color BUTTON_COLOR = {70, 130, 180, 255};
 const SDL_Color BUTTON_HOVER = {100, 180, 255, 255};
@@ -16,24 +24,31 @@ const std::vector<std::string> BUTTON_LABELS = {
     "STORY", "NEW GAME", "MAP", "LEADERBOARD", "CREDITS", "EXIT"
 };
 
+// Greedy word wrap. Each word is measured once and lines are summed from
+// the word advances, so the cost is linear in the length of the text.
 std::vector<std::string> wrapText(const std::string& text, TTF_Font* font, int maxWidth) {
     std::vector<std::string> lines;
     std::string currentLine;
+    int currentWidth = 0;
+    int spaceWidth = 0;
+    TTF_SizeUTF8(font, " ", &spaceWidth, nullptr);
+
     std::istringstream words(text);
     std::string word;
-
     while (words >> word) {
-        std::string testLine = currentLine.empty() ? word : currentLine + " " + word;
-        SDL_Surface* testSurface = TTF_RenderText_Blended(font, testLine.c_str(), TEXT_COLOR);
-        if (testSurface && testSurface->w > maxWidth) {
-            if (!currentLine.empty()) {
-                lines.push_back(currentLine);
-                currentLine = word;
-            }
-        } else {
-            currentLine = testLine;
+        int wordWidth = 0;
+        TTF_SizeUTF8(font, word.c_str(), &wordWidth, nullptr);
+        if (!currentLine.empty() && currentWidth + spaceWidth + wordWidth > maxWidth) {
+            lines.push_back(currentLine);
+            currentLine.clear();
+            currentWidth = 0;
+        }
+        if (!currentLine.empty()) {
+            currentLine += ' ';
+            currentWidth += spaceWidth;
         }
-        SDL_FreeSurface(testSurface);
+        currentLine += word;
+        currentWidth += wordWidth;
     }
 
     if (!currentLine.empty()) {
@@ -43,256 +58,379 @@ std::vector<std::string> wrapText(const std::string& text, TTF_Font* font, int m
     return lines;
 }
 
-GameState runMenu(GameContext& ctx) {
-    SDL_Renderer* renderer = ctx.renderer;
-    SDL_Window* window = ctx.window;
+// ----------------------------------------------------
+// TextPage: wrapped lines rasterized once into strips of at most
+// STRIP_HEIGHT pixels (one tall texture could exceed what the GPU allows).
+// Scrolling only moves the source rects; nothing is rasterized per frame.
+// ----------------------------------------------------
+struct TextPage {
+    static const int STRIP_HEIGHT = 2048;
 
-    SDL_Texture* bg = IMG_LoadTexture(renderer, "assets/images/menu.png");
-    if (!bg) std::cerr << "Failed to load menu.png: " << IMG_GetError() << std::endl;
+    struct Strip {
+        SDL_Texture* texture;
+        int y, h;
+    };
 
-    Mix_Music* menuMusic = Mix_LoadMUS("assets/audio/menu_background.mp3");
-    if (menuMusic) {
-        Mix_PlayMusic(menuMusic, -1);
+    std::vector<Strip> strips;
+    int height = 0;
+
+    void build(SDL_Renderer* renderer, TTF_Font* font, const std::vector<std::string>& lines,
+               int width, int lineGap, SDL_Color color) {
+        clear();
+        int lineHeight = TTF_FontHeight(font) + lineGap;
+        size_t linesPerStrip = std::max(1, STRIP_HEIGHT / lineHeight);
+
+        for (size_t first = 0; first < lines.size(); first += linesPerStrip) {
+            size_t last = std::min(lines.size(), first + linesPerStrip);
+            int stripHeight = int(last - first) * lineHeight;
+            SDL_Surface* strip = SDL_CreateRGBSurfaceWithFormat(0, width, stripHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+            if (!strip) break;
+            SDL_FillRect(strip, nullptr, 0);
+
+            for (size_t i = first; i < last; ++i) {
+                if (lines[i].empty()) continue;
+                SDL_Surface* line = TTF_RenderUTF8_Blended(font, lines[i].c_str(), color);
+                if (!line) continue;
+                // Copy, not blend: lines never overlap and the strip starts transparent
+                SDL_SetSurfaceBlendMode(line, SDL_BLENDMODE_NONE);
+                SDL_Rect dst = {0, int(i - first) * lineHeight, line->w, line->h};
+                SDL_BlitSurface(line, nullptr, strip, &dst);
+                SDL_FreeSurface(line);
+            }
+
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, strip);
+            SDL_FreeSurface(strip);
+            if (!texture) break;
+            strips.push_back({texture, height, stripHeight});
+            height += stripHeight;
+        }
     }
 
-    TTF_Font* font = TTF_OpenFont("assets/fonts/OpenSans-Bold.ttf", 36);
-    TTF_Font* titleFont = TTF_OpenFont("assets/fonts/OpenSans-Bold.ttf", 48);
-    if (!font || !titleFont) {
-        std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
-        return EXIT;
+    // Draws the part of the page from offset down that fits in viewHeight
+    void draw(SDL_Renderer* renderer, int x, int y, int offset, int viewHeight) const {
+        for (const Strip& strip : strips) {
+            int top = std::max(offset, strip.y);
+            int bottom = std::min(offset + viewHeight, strip.y + strip.h);
+            if (top >= bottom) continue;
+            int w = 0;
+            SDL_QueryTexture(strip.texture, nullptr, nullptr, &w, nullptr);
+            SDL_Rect src = {0, top - strip.y, w, bottom - top};
+            SDL_Rect dst = {x, y + top - offset, w, bottom - top};
+            SDL_RenderCopy(renderer, strip.texture, &src, &dst);
+        }
     }
 
-    std::vector<Button> buttons;
-    int btnWidth = 300, btnHeight = 60;
-    int startY = 160;
-    for (size_t i = 0; i < BUTTON_LABELS.size(); ++i) {
-        int x = (720 - btnWidth) / 2;
-        int y = startY + static_cast<int>(i) * (btnHeight + 10);
-        buttons.emplace_back(x, y, btnWidth, btnHeight, BUTTON_LABELS[i], BUTTON_COLOR);
+    void clear() {
+        for (Strip& strip : strips) SDL_DestroyTexture(strip.texture);
+        strips.clear();
+        height = 0;
     }
+};
 
-    bool running = true;
-    bool showingMap = false, showingLeaderboard = false, showingStory = false, showingCredits = false;
-    GameState result = EXIT;
-    SDL_Event e;
+// ----------------------------------------------------
+// Label: a string rasterized once and drawn with a single copy. Hovering a
+// button only changes the fill behind it, so labels are built when the
+// menu is entered and never again (the rank notice when the rank changes).
+// ----------------------------------------------------
+struct Label {
+    SDL_Texture* texture = nullptr;
+    SDL_Rect rect = {0, 0, 0, 0};
 
-    SDL_Texture* mapTex = nullptr, *leaderboardBgTex = nullptr, *storyBgTex = nullptr, *clickedImage = nullptr;
-    Button backButton((720 - 200) / 2, 500, 200, 50, "MENU", BUTTON_COLOR);
+    bool build(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color) {
+        clear();
+        SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
+        if (!surface) return false;
+        texture = SDL_CreateTextureFromSurface(renderer, surface);
+        rect.w = surface->w;
+        rect.h = surface->h;
+        SDL_FreeSurface(surface);
+        return texture != nullptr;
+    }
 
-    std::vector<std::string> leaderboardLines;
-    std::string storyText;
+    void centerIn(const SDL_Rect& area) {
+        rect.x = area.x + (area.w - rect.w) / 2;
+        rect.y = area.y + (area.h - rect.h) / 2;
+    }
 
-    std::ifstream storyFile("assets/story.txt");
-    if (!storyFile) {
-        std::cerr << "Failed to open story.txt" << std::endl;
-        return EXIT;
+    void draw(SDL_Renderer* renderer) const {
+        if (texture) SDL_RenderCopy(renderer, texture, nullptr, &rect);
     }
-    std::string line;
-    while (std::getline(storyFile, line)) storyText += line + "\n";
 
-    int scrollOffset = 0, totalHeight = 0;
-    const int scrollSpeed = 20, maxHeight = 600, maxWidth = 700;
-    std::vector<std::string> wrappedText = wrapText(storyText, font, maxWidth);
-    for (const auto& line : wrappedText) {
-        SDL_Surface* surface = TTF_RenderText_Blended(font, line.c_str(), TEXT_COLOR);
-        totalHeight += surface->h + 10;
-        SDL_FreeSurface(surface);
+    void clear() {
+        if (texture) SDL_DestroyTexture(texture);
+        texture = nullptr;
     }
-    int maxScrollOffset = std::max(0, totalHeight - maxHeight);
-
-    std::vector<std::string> names = {"Jahid", "Apon", "Soumik", "Turja"};
-    std::vector<SDL_Rect> nameRects;
-    std::string clickedName = "";
-
-    while (running) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                running = false;
-                result = EXIT;
-            } else if (e.type == SDL_MOUSEMOTION) {
-                int mx = e.motion.x, my = e.motion.y;
-                SDL_Point pt = {mx, my};
-                backButton.isHovered = (showingStory || showingLeaderboard || showingMap || showingCredits) && SDL_PointInRect(&pt, &backButton.rect);
-                if (!showingMap && !showingLeaderboard && !showingStory && !showingCredits) {
-                    for (auto& btn : buttons)
-                        btn.isHovered = SDL_PointInRect(&pt, &btn.rect);
-                }
-            } else if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
-                int mx = e.button.x, my = e.button.y;
-                SDL_Point pt = {mx, my};
-                if ((showingMap || showingLeaderboard || showingStory || showingCredits) && SDL_PointInRect(&pt, &backButton.rect)) {
-                    showingMap = showingLeaderboard = showingStory = showingCredits = false;
-                    if (mapTex) { SDL_DestroyTexture(mapTex); mapTex = nullptr; }
-                    if (leaderboardBgTex) { SDL_DestroyTexture(leaderboardBgTex); leaderboardBgTex = nullptr; }
-                    if (storyBgTex) { SDL_DestroyTexture(storyBgTex); storyBgTex = nullptr; }
-                    if (clickedImage) { SDL_DestroyTexture(clickedImage); clickedImage = nullptr; }
-                    clickedName = "";
-                } else if (!showingMap && !showingLeaderboard && !showingStory && !showingCredits) {
-                    for (const auto& btn : buttons) {
-                        if (SDL_PointInRect(&pt, &btn.rect)) {
-                            if (btn.label == "NEW GAME") {
-                                resetGameProgress();
-                                if (getPlayerName(ctx, font)) result = FLOOR1;
-                                else result = MENU;
-                                running = false;
-                                break;
-                            } else if (btn.label == "MAP") {
-                                mapTex = IMG_LoadTexture(renderer, "assets/images/map.png");
-                                if (!mapTex) std::cerr << "Failed to load map.png: " << IMG_GetError() << std::endl;
-                                else showingMap = true;
-                            } else if (btn.label == "LEADERBOARD") {
-                                leaderboardBgTex = IMG_LoadTexture(renderer, "assets/images/leaderboard_background.png");
-                                if (!leaderboardBgTex) {
-                                    std::cerr << "Failed to load leaderboard background: " << IMG_GetError() << std::endl;
-                                } else {
-                                    leaderboardLines.clear();
-                                    std::ifstream lbFile("leaderboard.txt");
-                                    if (!lbFile) {
-                                        std::cerr << "Failed to open leaderboard.txt" << std::endl;
-                                    } else {
-                                        std::string entry;
-                                        while (std::getline(lbFile, entry)) {
-                                            leaderboardLines.push_back(entry);
-                                        }
-                                    }
-                                    showingLeaderboard = true;
-                                }
-                            } else if (btn.label == "STORY") {
-                                storyBgTex = IMG_LoadTexture(renderer, "assets/images/back.png");
-                                showingStory = true;
-                            } else if (btn.label == "CREDITS") {
-                                showingCredits = true;
-                            } else if (btn.label == "EXIT") {
-                                result = EXIT;
-                                running = false;
-                                break;
-                            }
+};
+
+// Everything the menu's pages show, loaded in the background once the
+// title menu is up and held while the menu is on the stack
+static const std::vector<std::string> CREDIT_NAMES = {"Jahid", "Apon", "Soumik", "Turja"};
+
+static const AssetList& menuAssets() {
+    static const AssetList assets = [] {
+        AssetList list;
+        list.images = {
+            "assets/images/map.png", "assets/images/back.png",
+            "assets/images/leaderboard_background.png"
+        };
+        for (const std::string& name : CREDIT_NAMES)
+            list.images.push_back("assets/images/credits/" + name + ".png");
+        return list;
+    }();
+    return assets;
+}
+
+// ----------------------------------------------------
+// MenuScene: the title menu plus its story, map and credits pages.
+// LEADERBOARD and NEW GAME push their own scenes on top; the name entry
+// starts floor 1 through ctx.nextState; EXIT sets it to EXIT.
+//
+// The first frame shows only the title menu. After it, the story is laid
+// out and the pages' images are queued on AssetLoader, so opening a page
+// never waits on a decode.
+// ----------------------------------------------------
+class MenuScene : public Scene {
+public:
+    explicit MenuScene(GameContext& ctx) : ctx(ctx), renderer(ctx.renderer) {}
+
+    void enter() override {
+        bg = textures.acquire(renderer, "assets/images/menu.png");
+        if (!bg) std::cerr << "Failed to load menu.png: " << IMG_GetError() << std::endl;
+
+        menuMusic = Mix_LoadMUS("assets/audio/menu_background.mp3");
+        if (menuMusic) {
+            Mix_PlayMusic(menuMusic, -1);
+        }
+
+        font = FontRegistry::instance().get("OpenSans-Bold.ttf", 36);
+        titleFont = FontRegistry::instance().get("OpenSans-Bold.ttf", 48);
+        noticeFont = FontRegistry::instance().get("arial.ttf", 24);
+        if (!font || !titleFont) {
+            std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
+            ctx.nextState = EXIT;
+            return;
+        }
+
+        int btnWidth = 300, btnHeight = 60;
+        int startY = 160;
+        buttons.clear();
+        buttonLabels.resize(BUTTON_LABELS.size());
+        for (size_t i = 0; i < BUTTON_LABELS.size(); ++i) {
+            int x = (720 - btnWidth) / 2;
+            int y = startY + static_cast<int>(i) * (btnHeight + 10);
+            buttons.emplace_back(x, y, btnWidth, btnHeight, BUTTON_LABELS[i], BUTTON_COLOR);
+            buttonLabels[i].build(renderer, font, BUTTON_LABELS[i], TEXT_COLOR);
+            buttonLabels[i].centerIn(buttons[i].rect);
+        }
+
+        titleLabel.build(renderer, titleFont, "ESCAPE ROOM CONQUEST", TEXT_COLOR);
+        titleLabel.rect.x = (720 - titleLabel.rect.w) / 2 + 50;
+        titleLabel.rect.y = 80;
+        backLabel.build(renderer, font, backButton.label, TEXT_COLOR);
+        backLabel.centerIn(backButton.rect);
+
+        nameLabels.resize(CREDIT_NAMES.size());
+        int y = 150;
+        for (size_t i = 0; i < CREDIT_NAMES.size(); ++i) {
+            nameLabels[i].build(renderer, font, CREDIT_NAMES[i], TEXT_COLOR);
+            nameLabels[i].rect.x = (720 - nameLabels[i].rect.w) / 2;
+            nameLabels[i].rect.y = y;
+            y += nameLabels[i].rect.h + 20;
+        }
+
+        std::ifstream storyFile("assets/story.txt");
+        if (!storyFile) {
+            std::cerr << "Failed to open story.txt" << std::endl;
+            ctx.nextState = EXIT;
+            return;
+        }
+        std::string line;
+        storyText.clear();
+        while (std::getline(storyFile, line)) storyText += line + "\n";
+    }
+
+    void update(double dt) override {
+        if (!shown) return;
+        AssetLoader& loader = AssetLoader::instance();
+        if (!preloadQueued) {
+            story.build(renderer, font, wrapText(storyText, font, maxWidth), maxWidth, 10, TEXT_COLOR);
+            maxScrollOffset = std::max(0, story.height - maxHeight);
+            loader.queue(renderer, menuAssets());
+            preloadQueued = true;
+        }
+        if (!resident && loader.pump()) {
+            // Pin every page image for as long as the menu is up
+            for (const std::string& path : menuAssets().images)
+                pinned.push_back(textures.acquire(renderer, path));
+            mapTex = textures.acquire(renderer, "assets/images/map.png");
+            pageBg = textures.acquire(renderer, "assets/images/back.png");
+            resident = true;
+        }
+    }
+
+    void exit() override {
+        if (Mix_PlayingMusic()) Mix_HaltMusic();
+        if (menuMusic) Mix_FreeMusic(menuMusic);
+        menuMusic = nullptr;
+        story.clear();
+        titleLabel.clear();
+        backLabel.clear();
+        noticeLabel.clear();
+        noticeRank = 0;
+        for (Label& label : buttonLabels) label.clear();
+        for (Label& label : nameLabels) label.clear();
+        pinned.clear();
+        mapTex.reset();
+        pageBg.reset();
+        clickedImage.reset();
+        shown = preloadQueued = resident = false;
+    }
+
+    void handleEvent(const SDL_Event& e) override {
+        if (e.type == SDL_MOUSEMOTION) {
+            int mx = e.motion.x, my = e.motion.y;
+            SDL_Point pt = {mx, my};
+            backButton.isHovered = (showingStory || showingMap || showingCredits) && SDL_PointInRect(&pt, &backButton.rect);
+            if (!showingMap && !showingStory && !showingCredits) {
+                for (auto& btn : buttons)
+                    btn.isHovered = SDL_PointInRect(&pt, &btn.rect);
+            }
+        } else if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+            int mx = e.button.x, my = e.button.y;
+            SDL_Point pt = {mx, my};
+            if ((showingMap || showingStory || showingCredits) && SDL_PointInRect(&pt, &backButton.rect)) {
+                // The page images stay pinned; only the open portrait goes
+                showingMap = showingStory = showingCredits = false;
+                clickedImage.reset();
+            } else if (!showingMap && !showingStory && !showingCredits) {
+                for (const auto& btn : buttons) {
+                    if (SDL_PointInRect(&pt, &btn.rect)) {
+                        if (btn.label == "NEW GAME") {
+                            resetGameProgress();
+                            stack().push(createNameEntryScene(ctx, font), [this](bool entered) {
+                                if (entered) ctx.nextState = FLOOR1;
+                            });
+                            break;
+                        } else if (btn.label == "MAP") {
+                            if (!mapTex) mapTex = textures.acquire(renderer, "assets/images/map.png");
+                            if (!mapTex) std::cerr << "Failed to load map.png: " << IMG_GetError() << std::endl;
+                            else showingMap = true;
+                        } else if (btn.label == "LEADERBOARD") {
+                            stack().push(std::make_unique<LeaderboardScene>(renderer));
+                            break;
+                        } else if (btn.label == "STORY") {
+                            if (!pageBg) pageBg = textures.acquire(renderer, "assets/images/back.png");
+                            showingStory = true;
+                        } else if (btn.label == "CREDITS") {
+                            if (!pageBg) pageBg = textures.acquire(renderer, "assets/images/back.png");
+                            showingCredits = true;
+                        } else if (btn.label == "EXIT") {
+                            ctx.nextState = EXIT;
+                            break;
                         }
                     }
-                } else if (showingCredits) {
-                    for (size_t i = 0; i < nameRects.size(); ++i) {
-                        if (SDL_PointInRect(&pt, &nameRects[i])) {
-                            clickedName = names[i];
-                            if (clickedImage) {
-                                SDL_DestroyTexture(clickedImage);
-                                clickedImage = nullptr;
-                            }
-                            std::string path = "assets/images/credits/" + clickedName + ".png";
-                            clickedImage = IMG_LoadTexture(renderer, path.c_str());
-                        }
+                }
+            } else if (showingCredits) {
+                for (size_t i = 0; i < nameLabels.size(); ++i) {
+                    if (SDL_PointInRect(&pt, &nameLabels[i].rect)) {
+                        clickedImage = textures.acquire(renderer, "assets/images/credits/" + CREDIT_NAMES[i] + ".png");
                     }
                 }
-            } else if (e.type == SDL_MOUSEWHEEL) {
-                if (e.wheel.y > 0) scrollOffset = std::max(0, scrollOffset - scrollSpeed);
-                else scrollOffset = std::min(maxScrollOffset, scrollOffset + scrollSpeed);
             }
+        } else if (e.type == SDL_MOUSEWHEEL) {
+            if (e.wheel.y > 0) scrollOffset = std::max(0, scrollOffset - scrollSpeed);
+            else scrollOffset = std::min(maxScrollOffset, scrollOffset + scrollSpeed);
         }
+    }
 
+    void render(SDL_Renderer* renderer, float alpha) override {
         SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
         SDL_RenderClear(renderer);
 
 
         if (showingCredits) {
-            SDL_Texture* creditsBg = IMG_LoadTexture(renderer, "assets/images/back.png");
-            if (creditsBg) {
-                SDL_RenderCopy(renderer, creditsBg, nullptr, nullptr);
-                SDL_DestroyTexture(creditsBg);
+            if (pageBg) {
+                SDL_RenderCopy(renderer, pageBg, nullptr, nullptr);
             }
 
-            int y = 150;
-            nameRects.clear();
-            for (const std::string& name : names) {
-                SDL_Surface* surf = TTF_RenderText_Blended(font, name.c_str(), TEXT_COLOR);
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect rect = {(720 - surf->w) / 2, y, surf->w, surf->h};
-                nameRects.push_back(rect);
-                SDL_RenderCopy(renderer, tex, nullptr, &rect);
-                y += surf->h + 20;
-                SDL_FreeSurface(surf);
-                SDL_DestroyTexture(tex);
-            }
+            for (const Label& label : nameLabels) label.draw(renderer);
 
             if (clickedImage) {
                 SDL_Rect imgRect = {0, 0, 720, 720};
                 SDL_RenderCopy(renderer, clickedImage, nullptr, &imgRect);
             }
         } else if (showingStory) {
-            if (storyBgTex) {
-                SDL_RenderCopy(renderer, storyBgTex, nullptr, nullptr);
+            if (pageBg) {
+                SDL_RenderCopy(renderer, pageBg, nullptr, nullptr);
             }
 
-            int y = 40 - scrollOffset;
-            for (const auto& line : wrappedText) {
-                SDL_Surface* surf = TTF_RenderText_Blended(font, line.c_str(), TEXT_COLOR);
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect rect = {40, y, surf->w, surf->h};
-                SDL_RenderCopy(renderer, tex, nullptr, &rect);
-                y += surf->h + 10;
-                SDL_FreeSurface(surf);
-                SDL_DestroyTexture(tex);
-            }
+            // The page starts 40px down and scrolls up under the top edge
+            int hidden = std::max(0, scrollOffset - 40);
+            story.draw(renderer, 40, std::max(0, 40 - scrollOffset), hidden, maxHeight);
         } else if (showingMap && mapTex) {
             SDL_RenderCopy(renderer, mapTex, nullptr, nullptr);
-        } else if (showingLeaderboard && leaderboardBgTex) {
-            SDL_RenderCopy(renderer, leaderboardBgTex, nullptr, nullptr);
-
-            int y = 180;
-            for (const auto& entry : leaderboardLines) {
-                SDL_Surface* surf = TTF_RenderText_Blended(font, entry.c_str(), TEXT_COLOR);
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect rect = {(720 - surf->w) / 2, y, surf->w, surf->h};
-                SDL_RenderCopy(renderer, tex, nullptr, &rect);
-                y += surf->h + 10;
-                SDL_FreeSurface(surf);
-                SDL_DestroyTexture(tex);
-            }
         } else {
             if (bg) SDL_RenderCopy(renderer, bg, nullptr, nullptr);
-            if (titleFont) {
-                SDL_Surface* titleSurf = TTF_RenderText_Blended(titleFont, "ESCAPE ROOM CONQUEST", TEXT_COLOR);
-                SDL_Texture* titleTex = SDL_CreateTextureFromSurface(renderer, titleSurf);
-                SDL_Rect titleRect = {(720 - titleSurf->w) / 2 + 50, 80, titleSurf->w, titleSurf->h};
-                SDL_RenderCopy(renderer, titleTex, nullptr, &titleRect);
-                SDL_FreeSurface(titleSurf);
-                SDL_DestroyTexture(titleTex);
+            titleLabel.draw(renderer);
+            // Set by RunWriter's callback once the last escape is on disk
+            if (ctx.lastRank > 0 && noticeFont) {
+                if (noticeRank != ctx.lastRank) {
+                    noticeLabel.build(renderer, noticeFont, "Your escape ranked #" + std::to_string(ctx.lastRank), TEXT_COLOR);
+                    noticeLabel.rect.x = (720 - noticeLabel.rect.w) / 2 + 50;
+                    noticeLabel.rect.y = 30;
+                    noticeRank = ctx.lastRank;
+                }
+                noticeLabel.draw(renderer);
             }
-            for (const auto& btn : buttons) {
+            for (size_t i = 0; i < buttons.size(); ++i) {
+                const Button& btn = buttons[i];
                 SDL_SetRenderDrawColor(renderer, btn.isHovered ? BUTTON_HOVER.r : btn.color.r, btn.isHovered ? BUTTON_HOVER.g : btn.color.g, btn.isHovered ? BUTTON_HOVER.b : btn.color.b, 255);
                 SDL_RenderFillRect(renderer, &btn.rect);
-                SDL_Surface* textSurf = TTF_RenderText_Blended(font, btn.label.c_str(), TEXT_COLOR);
-                SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                int tx = btn.rect.x + (btn.rect.w - textSurf->w) / 2;
-                int ty = btn.rect.y + (btn.rect.h - textSurf->h) / 2;
-                SDL_Rect textRect = {tx, ty, textSurf->w, textSurf->h};
-                SDL_RenderCopy(renderer, textTex, nullptr, &textRect);
-                SDL_FreeSurface(textSurf);
-                SDL_DestroyTexture(textTex);
+                buttonLabels[i].draw(renderer);
             }
         }
 
-        if (showingMap || showingLeaderboard || showingStory || showingCredits) {
+        if (showingMap || showingStory || showingCredits) {
             SDL_SetRenderDrawColor(renderer, backButton.isHovered ? BUTTON_HOVER.r : backButton.color.r, backButton.isHovered ? BUTTON_HOVER.g : backButton.color.g, backButton.isHovered ? BUTTON_HOVER.b : backButton.color.b, 255);
             SDL_RenderFillRect(renderer, &backButton.rect);
-            SDL_Surface* labelSurf = TTF_RenderText_Blended(font, backButton.label.c_str(), TEXT_COLOR);
-            SDL_Texture* labelTex = SDL_CreateTextureFromSurface(renderer, labelSurf);
-            SDL_Rect labelRect = {backButton.rect.x + (backButton.rect.w - labelSurf->w) / 2, backButton.rect.y + (backButton.rect.h - labelSurf->h) / 2, labelSurf->w, labelSurf->h};
-            SDL_RenderCopy(renderer, labelTex, nullptr, &labelRect);
-            SDL_FreeSurface(labelSurf);
-            SDL_DestroyTexture(labelTex);
+            backLabel.draw(renderer);
         }
-
-  SDL_RenderPresent(renderer);
+        shown = true;
     }
 
-    if (bg) SDL_DestroyTexture(bg);
-    if (mapTex) SDL_DestroyTexture(mapTex);
-    if (leaderboardBgTex) SDL_DestroyTexture(leaderboardBgTex);
-    if (storyBgTex) SDL_DestroyTexture(storyBgTex);
-    if (clickedImage) SDL_DestroyTexture(clickedImage);
-    TTF_CloseFont(font);
-    TTF_CloseFont(titleFont);
-    if (Mix_PlayingMusic()) Mix_HaltMusic();
-    if (menuMusic) Mix_FreeMusic(menuMusic);
-
-    return result;
-}
\ No newline at end of file
+    // Nothing on these screens animates: redraw only after an event,
+    // once the background preload has landed
+    int redrawIntervalMs() const override { return resident ? FrameScheduler::IDLE_WAKE_MS : 0; }
+
+private:
+    GameContext& ctx;
+    SDL_Renderer* renderer;
+    TextureCache& textures = TextureCache::instance();
+    TextureHandle bg;
+    Mix_Music* menuMusic = nullptr;
+    TTF_Font* font = nullptr;
+    TTF_Font* titleFont = nullptr;
+    TTF_Font* noticeFont = nullptr;
+
+    std::vector<Button> buttons;
+    bool showingMap = false, showingStory = false, showingCredits = false;
+
+    TextureHandle mapTex, pageBg, clickedImage;
+    std::vector<TextureHandle> pinned;
+    bool shown = false, preloadQueued = false, resident = false;
+    Button backButton{(720 - 200) / 2, 500, 200, 50, "MENU", BUTTON_COLOR};
+
+    Label titleLabel, backLabel, noticeLabel;
+    std::vector<Label> buttonLabels, nameLabels;
+    size_t noticeRank = 0;
+
+    std::string storyText;
+    TextPage story;
+
+    int scrollOffset = 0, maxScrollOffset = 0;
+    const int scrollSpeed = 20, maxHeight = 600, maxWidth = 700;
+};
+
+std::unique_ptr<Scene> createMenuScene(GameContext& ctx) {
+    return std::make_unique<MenuScene>(ctx);
+}
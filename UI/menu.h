@@ -8,9 +8,12 @@
 #include "GameContext.h"
 #include "game_state.h"
 #include "button.h" // <-- Add this line
+#include "scene.h"
+#include <memory>
 
 // Remove the Button struct definition from here!
 
-GameState runMenu(GameContext& ctx);
+// Title menu; sets ctx.nextState to FLOOR1 (new game) or EXIT
+std::unique_ptr<Scene> createMenuScene(GameContext& ctx);
 
 #endif // MENU_H
\ No newline at end of file
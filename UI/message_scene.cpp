@@ -0,0 +1,38 @@
+#include "message_scene.h"
+#include <SDL2/SDL_ttf.h>
+#include "font_registry.h"
+
+// Where the floors have always stretched their notices to
+static const SDL_Rect MESSAGE_RECT = {250, 250, 300, 100};
+
+MessageScene::MessageScene(SDL_Renderer* renderer, const std::string& text,
+                           SDL_Color color, bool overlay, double seconds)
+    : renderer(renderer), text(text), color(color), overlay(overlay), remaining(seconds) {}
+
+void MessageScene::enter() {
+    // Rasterized once for the whole time the message is up
+    TTF_Font* font = FontRegistry::instance().get("arial.ttf", 36);
+    if (!font) return;
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
+    if (!surface) return;
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+}
+
+void MessageScene::exit() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+}
+
+void MessageScene::update(double dt) {
+    remaining -= dt;
+    if (remaining <= 0.0) finish();
+}
+
+void MessageScene::render(SDL_Renderer* renderer, float alpha) {
+    if (!overlay) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+    }
+    if (texture) SDL_RenderCopy(renderer, texture, nullptr, &MESSAGE_RECT);
+}
@@ -0,0 +1,34 @@
+#ifndef MESSAGE_SCENE_H
+#define MESSAGE_SCENE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include "scene.h"
+
+// ----------------------------------------------------
+// MessageScene shows a one-line notice ("Door Opened!") for a moment and
+// then finishes, swallowing input meanwhile. As an overlay it is drawn
+// over the scene underneath; otherwise on a cleared screen.
+// ----------------------------------------------------
+class MessageScene : public Scene {
+public:
+    MessageScene(SDL_Renderer* renderer, const std::string& text,
+                 SDL_Color color = {255, 255, 255, 255}, bool overlay = false, double seconds = 1.5);
+
+    void enter() override;
+    void exit() override;
+    void handleEvent(const SDL_Event& e) override {}
+    void update(double dt) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
+    bool isOverlay() const override { return overlay; }
+
+private:
+    SDL_Renderer* renderer;
+    std::string text;
+    SDL_Color color;
+    bool overlay;
+    double remaining;
+    SDL_Texture* texture = nullptr;
+};
+
+#endif // MESSAGE_SCENE_H
@@ -24,6 +24,9 @@ struct GameContext {
 
     // ⏱ Timer start point
     std::chrono::steady_clock::time_point startTime;
+
+    // Place of the last escape on the leaderboard once it is written, else 0
+    size_t lastRank = 0;
 };
 
 #endif // GAME_CONTEXT_H
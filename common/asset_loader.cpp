@@ -0,0 +1,176 @@
+// common/asset_loader.cpp
+#include "asset_loader.h"
+#include "texture_cache.h"
+#include "sound_bank.h"
+#include "asset_pack.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <iostream>
+
+// Upload budget per pump() so a loading screen keeps animating
+static const double PUMP_BUDGET_MS = 8.0;
+
+// Runs on a worker thread: nothing here may touch the renderer
+static void decode(const std::string& path, bool image, SDL_Surface*& surface, Mix_Chunk*& chunk) {
+    if (!image) {
+        chunk = Mix_LoadWAV(path.c_str());
+        return;
+    }
+    SDL_Surface* decoded = IMG_Load(path.c_str());
+    // Convert here so the upload on the main thread is a straight copy
+    if (decoded && decoded->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        surface = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(decoded);
+    } else {
+        surface = decoded;
+    }
+}
+
+AssetLoader& AssetLoader::instance() {
+    // Never destroyed: main() joins the workers with shutdown() while SDL is
+    // still up. A static destructor would run after SDL_Quit(), too late to
+    // free leftover surfaces, and would terminate the process on a joinable
+    // std::thread if shutdown() had been skipped.
+    static AssetLoader* loader = new AssetLoader();
+    return *loader;
+}
+
+void AssetLoader::start(int threadCount) {
+    if (!workers.empty()) return;
+    if (threadCount <= 0) threadCount = std::clamp(SDL_GetCPUCount() - 1, 1, 4);
+
+    stopping = false;
+    for (int i = 0; i < threadCount; ++i)
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+}
+
+void AssetLoader::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        pending.clear();
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+
+    for (Job& job : finished) {
+        if (job.surface) SDL_FreeSurface(job.surface);
+        if (job.chunk) Mix_FreeChunk(job.chunk);
+    }
+    finished.clear();
+    inFlight.clear();
+    cancelled.clear();
+    total = landed = 0;
+}
+
+void AssetLoader::queue(SDL_Renderer* renderer, const AssetList& list) {
+    if (isIdle()) total = landed = 0;  // start a fresh batch for progress reporting
+
+    AssetPack& pack = AssetPack::instance();
+    std::vector<Job> jobs;
+    for (const auto& path : list.images) {
+        if (TextureCache::instance().isLoaded(renderer, path)) continue;
+        // Packed pixels need no decoding, only the upload; do it right here
+        if (pack.contains(path)) {
+            TextureCache::instance().acquire(renderer, path);
+            continue;
+        }
+        if (inFlight.insert(path).second) jobs.push_back({Job::IMAGE, path, renderer});
+        else cancelled.erase(path);
+    }
+    for (const auto& path : list.sounds) {
+        if (SoundBank::instance().has(path)) continue;
+        if (pack.contains(path)) {
+            SoundBank::instance().get(path);
+            continue;
+        }
+        if (inFlight.insert(path).second) jobs.push_back({Job::SOUND, path, renderer});
+        else cancelled.erase(path);
+    }
+    if (jobs.empty()) return;
+
+    total += static_cast<int>(jobs.size());
+    if (workers.empty()) {
+        // No threads (start() never ran): decode here so callers still make progress
+        for (Job& job : jobs) {
+            decode(job.path, job.kind == Job::IMAGE, job.surface, job.chunk);
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(job);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.insert(pending.end(), jobs.begin(), jobs.end());
+    }
+    wake.notify_all();
+}
+
+void AssetLoader::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) return;
+            job = pending.front();
+            pending.pop_front();
+        }
+
+        decode(job.path, job.kind == Job::IMAGE, job.surface, job.chunk);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            if (job.surface) SDL_FreeSurface(job.surface);
+            if (job.chunk) Mix_FreeChunk(job.chunk);
+            return;
+        }
+        finished.push_back(job);
+    }
+}
+
+void AssetLoader::cancel(const std::string& path) {
+    if (inFlight.count(path)) cancelled.insert(path);
+}
+
+void AssetLoader::land(Job& job) {
+    if (cancelled.erase(job.path)) {
+        if (job.surface) SDL_FreeSurface(job.surface);
+        if (job.chunk) Mix_FreeChunk(job.chunk);
+    } else if (job.kind == Job::IMAGE) {
+        if (job.surface) {
+            TextureCache::instance().adopt(job.renderer, job.path, job.surface);
+            SDL_FreeSurface(job.surface);
+        } else {
+            std::cerr << "AssetLoader: failed to decode " << job.path << std::endl;
+        }
+    } else {
+        if (job.chunk) SoundBank::instance().adopt(job.path, job.chunk);
+        else std::cerr << "AssetLoader: failed to decode " << job.path << std::endl;
+    }
+    inFlight.erase(job.path);
+    ++landed;
+}
+
+bool AssetLoader::pump(const ProgressCallback& onProgress) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    int before = landed;
+
+    while (landed < total) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (finished.empty()) break;
+            job = finished.front();
+            finished.pop_front();
+        }
+        land(job);
+        if ((SDL_GetPerformanceCounter() - start) / ticksPerMs > PUMP_BUDGET_MS) break;
+    }
+
+    if (onProgress && (landed != before || landed == total)) onProgress(landed, total);
+    return isIdle();
+}
@@ -0,0 +1,83 @@
+// common/asset_loader.h
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Images and sound effects a floor (or screen) needs resident
+struct AssetList {
+    std::vector<std::string> images;
+    std::vector<std::string> sounds;
+};
+
+// ----------------------------------------------------
+// AssetLoader streams assets in the background.
+// Worker threads decode PNGs into SDL_Surfaces and sounds into Mix_Chunks;
+// the main thread only uploads finished surfaces to the GPU in pump(),
+// which hands them to TextureCache and SoundBank.
+// ----------------------------------------------------
+class AssetLoader {
+public:
+    // Reported from pump() on the main thread as assets land
+    using ProgressCallback = std::function<void(int loaded, int total)>;
+
+    static AssetLoader& instance();
+
+    // Spawn the worker threads (0 picks a count from the CPU count)
+    void start(int threadCount = 0);
+
+    // Stop the workers and drop anything not yet uploaded;
+    // call before Mix_CloseAudio()/IMG_Quit()
+    void shutdown();
+
+    // Queue every asset in list that is not resident or in flight yet
+    void queue(SDL_Renderer* renderer, const AssetList& list);
+
+    // Main thread: adopt decoded assets for a few milliseconds at most.
+    // Returns true once everything queued so far has landed.
+    bool pump(const ProgressCallback& onProgress = nullptr);
+
+    bool isIdle() const { return landed == total; }
+
+    // Drop path when it lands instead of handing it to TextureCache or
+    // SoundBank; nothing happens if it is not in flight. Queueing it
+    // again before then takes the cancel back.
+    void cancel(const std::string& path);
+
+private:
+    struct Job {
+        enum Kind { IMAGE, SOUND } kind;
+        std::string path;
+        SDL_Renderer* renderer = nullptr;
+        SDL_Surface* surface = nullptr;
+        Mix_Chunk* chunk = nullptr;
+    };
+
+    AssetLoader() = default;
+    void workerLoop();
+    void land(Job& job);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> pending;   // waiting for a worker
+    std::deque<Job> finished;  // decoded, waiting for pump()
+    bool stopping = false;
+
+    // Main-thread bookkeeping for the current batch
+    std::set<std::string> inFlight;
+    std::set<std::string> cancelled;  // in flight, but no longer wanted
+    int total = 0;
+    int landed = 0;
+};
+
+#endif // ASSET_LOADER_H
@@ -0,0 +1,132 @@
+// common/asset_pack.cpp
+#include "asset_pack.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <fstream>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+static std::vector<unsigned char> packBuffer;  // no mmap: read the file once instead
+#endif
+
+AssetPack& AssetPack::instance() {
+    static AssetPack pack;
+    return pack;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    packBuffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(packBuffer.data()), packBuffer.size());
+    data = packBuffer.data();
+    length = packBuffer.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;  // No pack: loose files only
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(PackHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        std::cerr << "AssetPack: mmap failed for " << path << std::endl;
+        return false;
+    }
+    data = static_cast<const unsigned char*>(mapped);
+    length = static_cast<size_t>(info.st_size);
+#endif
+
+    const PackHeader* header = reinterpret_cast<const PackHeader*>(data);
+    size_t indexEnd = sizeof(PackHeader) + static_cast<size_t>(header->entryCount) * sizeof(PackEntry);
+    if (std::memcmp(header->magic, PACK_MAGIC, 4) != 0 || header->version != PACK_VERSION || indexEnd > length) {
+        std::cerr << "AssetPack: " << path << " is not a version " << PACK_VERSION << " pack" << std::endl;
+        close();
+        return false;
+    }
+
+    const PackEntry* entries = reinterpret_cast<const PackEntry*>(data + sizeof(PackHeader));
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const PackEntry& entry = entries[i];
+        // Written so a corrupt offset or size cannot wrap around
+        if (entry.offset > length || entry.size > length - entry.offset) continue;
+        // An image's pixels must all be there for createTexture() to read
+        if (entry.type == PackEntry::IMAGE && entry.size < uint64_t(entry.width) * entry.height * 4) continue;
+        index[std::string(entry.name, strnlen(entry.name, sizeof(entry.name)))] = &entry;
+    }
+
+    // Packed PCM is only usable if the mixer was opened with the same spec
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    soundsUsable = Mix_QuerySpec(&frequency, &format, &channels) &&
+                   frequency == header->audioFrequency && format == header->audioFormat &&
+                   channels == header->audioChannels;
+    if (!soundsUsable)
+        std::cerr << "AssetPack: audio format differs from the mixer; decoding sounds from assets/" << std::endl;
+    return true;
+}
+
+void AssetPack::close() {
+    index.clear();
+    soundsUsable = false;
+    if (!data) return;
+#ifdef _WIN32
+    packBuffer.clear();
+    packBuffer.shrink_to_fit();
+#else
+    munmap(const_cast<unsigned char*>(data), length);
+#endif
+    data = nullptr;
+    length = 0;
+}
+
+const PackEntry* AssetPack::find(const std::string& path, uint32_t type) const {
+    auto it = index.find(path);
+    if (it == index.end() || it->second->type != type) return nullptr;
+    return it->second;
+}
+
+bool AssetPack::contains(const std::string& path) const {
+    auto it = index.find(path);
+    if (it == index.end()) return false;
+    return it->second->type == PackEntry::IMAGE || soundsUsable;
+}
+
+SDL_Texture* AssetPack::createTexture(SDL_Renderer* renderer, const std::string& path) const {
+    const PackEntry* entry = find(path, PackEntry::IMAGE);
+    if (!entry) return nullptr;
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                             entry->width, entry->height);
+    if (!texture) {
+        std::cerr << "AssetPack: SDL_CreateTexture failed for " << path << ": " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_UpdateTexture(texture, nullptr, data + entry->offset, entry->width * 4);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);  // as SDL_CreateTextureFromSurface does for alpha
+    return texture;
+}
+
+Mix_Chunk* AssetPack::createChunk(const std::string& path) const {
+    if (!soundsUsable) return nullptr;
+    const PackEntry* entry = find(path, PackEntry::SOUND);
+    if (!entry) return nullptr;
+
+    // The mixer only reads abuf, so pointing it at read-only pages is fine
+    return Mix_QuickLoad_RAW(const_cast<Uint8*>(data + entry->offset), static_cast<Uint32>(entry->size));
+}
@@ -0,0 +1,82 @@
+// common/asset_pack.h
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// ----------------------------------------------------
+// On-disk layout of assets.pak (written by tools/asset_packer, native
+// byte order). A header, then entryCount PackEntry records, then the
+// payloads, each aligned to PACK_ALIGN:
+//  - images: width * height ARGB8888 pixels, pitch = width * 4
+//  - sounds: PCM already in the mixer format named by the header
+// ----------------------------------------------------
+static const char PACK_MAGIC[4] = {'E', 'R', 'P', 'K'};
+static const uint32_t PACK_VERSION = 1;
+static const uint64_t PACK_ALIGN = 64;
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    int32_t audioFrequency;
+    uint16_t audioFormat;
+    uint16_t audioChannels;
+    uint32_t reserved[3];
+};
+
+struct PackEntry {
+    enum Type : uint32_t { IMAGE = 0, SOUND = 1 };
+
+    char name[112];  // path as the game asks for it, e.g. "assets/images/floor1.png"
+    uint32_t type;
+    uint32_t width;   // images only
+    uint32_t height;  // images only
+    uint32_t reserved;
+    uint64_t offset;  // from the start of the file
+    uint64_t size;
+};
+
+// ----------------------------------------------------
+// AssetPack maps assets.pak read-only and serves textures and chunks
+// straight out of the mapping. Pixels go to the GPU with one
+// SDL_UpdateTexture; chunks point into the mapping, so nothing is copied
+// or decoded. TextureCache and SoundBank consult the pack before the
+// loose files under assets/.
+// ----------------------------------------------------
+class AssetPack {
+public:
+    static AssetPack& instance();
+
+    // Maps the pack; returns false (and leaves the game on loose files)
+    // if it is missing or was built for another format
+    bool open(const std::string& path);
+
+    // Unmaps the pack. Chunks created from it must be freed first
+    // (SoundBank::clear()), since they point into the mapping.
+    void close();
+
+    bool contains(const std::string& path) const;
+
+    // nullptr if path is not packed
+    SDL_Texture* createTexture(SDL_Renderer* renderer, const std::string& path) const;
+
+    // Borrowed-memory chunk; Mix_FreeChunk() frees only the chunk struct
+    Mix_Chunk* createChunk(const std::string& path) const;
+
+private:
+    AssetPack() = default;
+    const PackEntry* find(const std::string& path, uint32_t type) const;
+
+    const unsigned char* data = nullptr;
+    size_t length = 0;
+    bool soundsUsable = false;  // pack audio matches the opened mixer
+    std::map<std::string, const PackEntry*> index;
+};
+
+#endif // ASSET_PACK_H
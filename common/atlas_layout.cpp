@@ -0,0 +1,140 @@
+// common/atlas_layout.cpp
+#include "atlas_layout.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+// Area-averaging downscale; SDL_BlitScaled is nearest-neighbour, which
+// turns a 1024px sprite drawn at 16px into noise
+static SDL_Surface* shrink(SDL_Surface* source, int maxSide) {
+    SDL_Surface* src = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!src) return nullptr;
+    int longest = std::max(src->w, src->h);
+    if (longest <= maxSide) return src;
+
+    int w = std::max(1, src->w * maxSide / longest);
+    int h = std::max(1, src->h * maxSide / longest);
+    SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!dst) {
+        SDL_FreeSurface(src);
+        return nullptr;
+    }
+
+    SDL_LockSurface(src);
+    SDL_LockSurface(dst);
+    for (int y = 0; y < h; ++y) {
+        int y0 = y * src->h / h, y1 = std::max(y0 + 1, (y + 1) * src->h / h);
+        Uint32* out = reinterpret_cast<Uint32*>(static_cast<Uint8*>(dst->pixels) + y * dst->pitch);
+        for (int x = 0; x < w; ++x) {
+            int x0 = x * src->w / w, x1 = std::max(x0 + 1, (x + 1) * src->w / w);
+
+            // Colour is weighted by alpha so transparent edges do not darken
+            Uint64 a = 0, r = 0, g = 0, b = 0;
+            for (int sy = y0; sy < y1; ++sy) {
+                const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<Uint8*>(src->pixels) + sy * src->pitch);
+                for (int sx = x0; sx < x1; ++sx) {
+                    Uint32 p = row[sx], pa = p >> 24;
+                    a += pa;
+                    r += ((p >> 16) & 0xFF) * pa;
+                    g += ((p >> 8) & 0xFF) * pa;
+                    b += (p & 0xFF) * pa;
+                }
+            }
+            Uint64 count = Uint64(y1 - y0) * (x1 - x0);
+            out[x] = a ? Uint32(a / count) << 24 | Uint32(r / a) << 16 | Uint32(g / a) << 8 | Uint32(b / a) : 0;
+        }
+    }
+    SDL_UnlockSurface(dst);
+    SDL_UnlockSurface(src);
+    SDL_FreeSurface(src);
+    return dst;
+}
+
+SDL_Surface* buildAtlasSurface(const std::vector<std::string>& sources, std::vector<AtlasRegion>& regions,
+                               int maxSprite) {
+    std::vector<SDL_Surface*> sprites;
+    for (const std::string& path : sources) {
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        SDL_Surface* sprite = loaded ? shrink(loaded, maxSprite) : nullptr;
+        if (loaded) SDL_FreeSurface(loaded);
+        if (!sprite) {
+            std::cerr << "Atlas: cannot load " << path << ": " << IMG_GetError() << std::endl;
+            for (SDL_Surface* s : sprites) SDL_FreeSurface(s);
+            return nullptr;
+        }
+        sprites.push_back(sprite);
+    }
+    return packAtlasSurface(sprites, sources, regions);
+}
+
+SDL_Surface* packAtlasSurface(const std::vector<SDL_Surface*>& sprites, const std::vector<std::string>& names,
+                              std::vector<AtlasRegion>& regions) {
+    // Shelf packing, tallest first
+    std::vector<size_t> order(sprites.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sprites[a]->h > sprites[b]->h; });
+
+    regions.assign(sprites.size(), AtlasRegion());
+    int x = ATLAS_PADDING, y = ATLAS_PADDING, shelfHeight = 0, width = 0;
+    for (size_t i : order) {
+        SDL_Surface* s = sprites[i];
+        if (x + s->w + ATLAS_PADDING > ATLAS_MAX_WIDTH && x > ATLAS_PADDING) {
+            x = ATLAS_PADDING;
+            y += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        regions[i] = {names[i], {x, y, s->w, s->h}};
+        x += s->w + ATLAS_PADDING;
+        width = std::max(width, x);
+        shelfHeight = std::max(shelfHeight, s->h);
+    }
+    int height = y + shelfHeight + ATLAS_PADDING;
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, std::max(width, 1), height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (atlas) {
+        SDL_FillRect(atlas, nullptr, 0);
+        for (size_t i = 0; i < sprites.size(); ++i) {
+            SDL_SetSurfaceBlendMode(sprites[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = regions[i].rect;
+            SDL_BlitSurface(sprites[i], nullptr, atlas, &dst);
+        }
+    } else {
+        std::cerr << "Atlas: cannot create a " << width << "x" << height << " surface: " << SDL_GetError() << std::endl;
+    }
+    for (SDL_Surface* s : sprites) SDL_FreeSurface(s);
+    return atlas;
+}
+
+bool writeAtlasTable(const std::string& path, const std::vector<AtlasRegion>& regions, int width, int height) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "atlas " << width << " " << height << "\n";
+    for (const AtlasRegion& region : regions) {
+        out << region.name << " " << region.rect.x << " " << region.rect.y << " "
+            << region.rect.w << " " << region.rect.h << "\n";
+    }
+    return bool(out);
+}
+
+bool readAtlasTable(const std::string& path, std::vector<AtlasRegion>& regions) {
+    std::ifstream in(path);
+    std::string line, tag;
+    int width = 0, height = 0;
+    if (!std::getline(in, line) || !(std::istringstream(line) >> tag >> width >> height) || tag != "atlas") return false;
+
+    regions.clear();
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        AtlasRegion region;
+        std::istringstream fields(line);
+        if (!(fields >> region.name >> region.rect.x >> region.rect.y >> region.rect.w >> region.rect.h)) {
+            std::cerr << "Atlas: bad line in " << path << ": " << line << std::endl;
+            return false;
+        }
+        regions.push_back(region);
+    }
+    return true;
+}
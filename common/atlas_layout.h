@@ -0,0 +1,41 @@
+// common/atlas_layout.h
+#ifndef ATLAS_LAYOUT_H
+#define ATLAS_LAYOUT_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------
+// Shared by tools/atlas_packer and SpriteAtlas's runtime fallback, so an
+// atlas packed offline and one packed at startup come out identical.
+//
+// A .atlas table is plain text next to its .png:
+//     atlas <width> <height>
+//     <source path> <x> <y> <w> <h>      one line per sprite
+// ----------------------------------------------------
+static const int ATLAS_MAX_WIDTH = 2048;
+static const int ATLAS_PADDING = 2;        // transparent gap against filtering bleed
+static const int ATLAS_MAX_SPRITE = 256;   // longest side a sprite is shrunk to
+
+struct AtlasRegion {
+    std::string name;  // source path, e.g. "assets/images/hero.png"
+    SDL_Rect rect;
+};
+
+// Loads every source, shrinks it to maxSprite (box filter), and packs
+// them into shelves. Returns an ARGB8888 surface the caller frees, with
+// regions in the same order as sources; nullptr if any source fails.
+SDL_Surface* buildAtlasSurface(const std::vector<std::string>& sources, std::vector<AtlasRegion>& regions,
+                               int maxSprite = ATLAS_MAX_SPRITE);
+
+// The packing half of buildAtlasSurface, for sprites already in memory
+// (rendered text, ...). Frees every sprite; regions follow their order
+// and take their names from names.
+SDL_Surface* packAtlasSurface(const std::vector<SDL_Surface*>& sprites, const std::vector<std::string>& names,
+                              std::vector<AtlasRegion>& regions);
+
+bool writeAtlasTable(const std::string& path, const std::vector<AtlasRegion>& regions, int width, int height);
+bool readAtlasTable(const std::string& path, std::vector<AtlasRegion>& regions);
+
+#endif // ATLAS_LAYOUT_H
@@ -0,0 +1,113 @@
+// common/durable_file.cpp
+#include "durable_file.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+static bool writeAll(const std::string& path, const char* mode, const void* data, size_t size, bool sync) {
+    FILE* file = std::fopen(path.c_str(), mode);
+    if (!file) return false;
+    bool ok = std::fwrite(data, 1, size, file) == size && std::fflush(file) == 0;
+    if (ok && sync) ok = _commit(_fileno(file)) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+bool writeFileAtomic(const std::string& path, const void* data, size_t size) {
+    const std::string temp = path + ".tmp";
+    if (!writeAll(temp, "wb", data, size, true)) {
+        std::cerr << "writeFileAtomic: cannot write " << temp << std::endl;
+        return false;
+    }
+    if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        std::cerr << "writeFileAtomic: cannot replace " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool appendFile(const std::string& path, const void* data, size_t size, bool sync) {
+    return writeAll(path, "ab", data, size, sync);
+}
+
+bool truncateFile(const std::string& path, size_t size) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER offset;
+    offset.QuadPart = static_cast<LONGLONG>(size);
+    bool ok = SetFilePointerEx(file, offset, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+    CloseHandle(file);
+    return ok;
+}
+
+#else
+
+static bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// The rename itself is only durable once the directory entry is flushed
+static void syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
+
+bool writeFileAtomic(const std::string& path, const void* data, size_t size) {
+    const std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "writeFileAtomic: cannot create " << temp << std::endl;
+        return false;
+    }
+    bool ok = writeAll(fd, data, size) && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || ::rename(temp.c_str(), path.c_str()) != 0) {
+        std::cerr << "writeFileAtomic: cannot replace " << path << std::endl;
+        ::unlink(temp.c_str());
+        return false;
+    }
+    syncParentDirectory(path);
+    return true;
+}
+
+bool appendFile(const std::string& path, const void* data, size_t size, bool sync) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+    bool ok = writeAll(fd, data, size) && (!sync || ::fsync(fd) == 0);
+    return ::close(fd) == 0 && ok;
+}
+
+bool truncateFile(const std::string& path, size_t size) {
+    return ::truncate(path.c_str(), static_cast<off_t>(size)) == 0;
+}
+
+#endif
+
+bool readFile(const std::string& path, std::vector<unsigned char>& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    out.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return bool(file.read(reinterpret_cast<char*>(out.data()), out.size()));
+}
@@ -0,0 +1,26 @@
+// common/durable_file.h
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------
+// Small file helpers for data that must survive a crash or power cut.
+//
+// writeFileAtomic() writes to <path>.tmp, flushes it to disk and renames
+// it over path, so a reader sees either the old file or the new one,
+// never half of each. appendFile() with sync set returns only once the
+// bytes are on disk.
+// ----------------------------------------------------
+bool writeFileAtomic(const std::string& path, const void* data, size_t size);
+bool appendFile(const std::string& path, const void* data, size_t size, bool sync);
+
+// Whole file into out; false if it cannot be opened
+bool readFile(const std::string& path, std::vector<unsigned char>& out);
+
+// Cuts path down to size bytes (drops a torn tail after a crash)
+bool truncateFile(const std::string& path, size_t size);
+
+#endif // DURABLE_FILE_H
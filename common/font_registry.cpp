@@ -0,0 +1,50 @@
+// common/font_registry.cpp
+#include "font_registry.h"
+#include <iostream>
+#include <set>
+
+static const std::string FONT_DIR = "assets/fonts/";
+
+FontRegistry& FontRegistry::instance() {
+    static FontRegistry registry;
+    return registry;
+}
+
+void FontRegistry::setFallbackFace(const std::string& face) {
+    fallbackFace = face;
+}
+
+void FontRegistry::preload(const std::vector<std::pair<std::string, int>>& list) {
+    for (const auto& font : list) get(font.first, font.second);
+}
+
+TTF_Font* FontRegistry::get(const std::string& face, int pointSize) {
+    auto key = std::make_pair(face, pointSize);
+    auto it = fonts.find(key);
+    if (it != fonts.end()) return it->second;
+
+    TTF_Font* font = open(face, pointSize);
+    fonts.emplace(key, font);
+    return font;
+}
+
+TTF_Font* FontRegistry::open(const std::string& face, int pointSize) {
+    TTF_Font* font = TTF_OpenFont((FONT_DIR + face).c_str(), pointSize);
+    if (font) return font;
+
+    std::cerr << "Failed to open font " << face << ": " << TTF_GetError() << std::endl;
+    if (face == fallbackFace) return nullptr;
+
+    // Share the fallback's entry so it is only opened once per size
+    std::cerr << "Using fallback font " << fallbackFace << " instead" << std::endl;
+    return get(fallbackFace, pointSize);
+}
+
+void FontRegistry::clear() {
+    // Several keys may share one fallback font; close each pointer once
+    std::set<TTF_Font*> closed;
+    for (auto& entry : fonts) {
+        if (entry.second && closed.insert(entry.second).second) TTF_CloseFont(entry.second);
+    }
+    fonts.clear();
+}
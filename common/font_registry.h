@@ -0,0 +1,42 @@
+// common/font_registry.h
+#ifndef FONT_REGISTRY_H
+#define FONT_REGISTRY_H
+
+#include <SDL2/SDL_ttf.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------
+// FontRegistry opens each (face, point size) once per process.
+// Faces are file names under assets/fonts. When a face is missing the
+// declared fallback face is opened in its place, and that decision is
+// remembered, so frame loops never touch the filesystem.
+// Fonts handed out are borrowed: callers must not TTF_CloseFont them.
+// ----------------------------------------------------
+class FontRegistry {
+public:
+    static FontRegistry& instance();
+
+    // Face used when a requested file cannot be opened
+    void setFallbackFace(const std::string& face);
+
+    // Resolve a list of (face, size) pairs up front, at startup
+    void preload(const std::vector<std::pair<std::string, int>>& fonts);
+
+    // Borrowed pointer, or nullptr if neither the face nor the fallback opens
+    TTF_Font* get(const std::string& face, int pointSize);
+
+    // Closes every font; call before TTF_Quit()
+    void clear();
+
+private:
+    FontRegistry() = default;
+    TTF_Font* open(const std::string& face, int pointSize);
+
+    std::string fallbackFace = "DejaVuSans.ttf";
+    std::map<std::pair<std::string, int>, TTF_Font*> fonts;
+};
+
+#endif // FONT_REGISTRY_H
@@ -0,0 +1,156 @@
+// common/frame_profiler.cpp
+#include "frame_profiler.h"
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include "text_renderer.h"
+#include "font_registry.h"
+#include "frame_scheduler.h"
+
+static const char* PHASE_NAMES[FrameProfiler::PHASE_COUNT] = {
+    "events", "update", "render", "present"
+};
+
+static const SDL_Color PHASE_COLORS[FrameProfiler::PHASE_COUNT] = {
+    {255, 200, 60, 255}, {90, 220, 90, 255}, {80, 160, 255, 255}, {220, 90, 220, 255}
+};
+
+// Graph placement and scale: the full height is two 60 Hz frames
+static const SDL_Rect GRAPH_RECT = {10, 10, FrameProfiler::HISTORY, 100};
+static const float GRAPH_MAX_MS = 33.3f;
+
+FrameProfiler& FrameProfiler::instance() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+FrameProfiler::FrameProfiler()
+    : msPerTick(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency())) {
+    current = Sample{};
+}
+
+void FrameProfiler::beginFrame() {
+    frameStart = phaseStart = SDL_GetPerformanceCounter();
+    current = Sample{};
+}
+
+void FrameProfiler::endPhase(Phase phase) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    current.phaseMs[phase] += static_cast<float>((now - phaseStart) * msPerTick);
+    phaseStart = now;
+}
+
+void FrameProfiler::endFrame() {
+    current.frameMs = static_cast<float>((SDL_GetPerformanceCounter() - frameStart) * msPerTick);
+    history[next] = current;
+    next = (next + 1) % HISTORY;
+    if (count < HISTORY) ++count;
+}
+
+const FrameProfiler::Sample& FrameProfiler::sample(int i) const {
+    return history[(next - count + i + HISTORY) % HISTORY];
+}
+
+bool FrameProfiler::handleEvent(const SDL_Event& e) {
+    if (e.type != SDL_KEYDOWN || e.key.repeat) return false;
+
+    if (e.key.keysym.sym == TOGGLE_KEY) {
+        visible = !visible;
+        return true;
+    }
+    if (e.key.keysym.sym == DUMP_KEY) {
+        if (dumpCsv("frame_profile.csv")) std::cout << "Wrote frame_profile.csv\n";
+        return true;
+    }
+    return false;
+}
+
+bool FrameProfiler::dumpCsv(const std::string& path) const {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        std::cerr << "Failed to write " << path << "\n";
+        return false;
+    }
+
+    std::fprintf(out, "frame");
+    for (const char* name : PHASE_NAMES) std::fprintf(out, ",%s_ms", name);
+    std::fprintf(out, ",frame_ms\n");
+
+    for (int i = 0; i < count; ++i) {
+        const Sample& s = sample(i);
+        std::fprintf(out, "%d", i);
+        for (float ms : s.phaseMs) std::fprintf(out, ",%.3f", ms);
+        std::fprintf(out, ",%.3f\n", s.frameMs);
+    }
+
+    std::fclose(out);
+    return true;
+}
+
+void FrameProfiler::draw(SDL_Renderer* renderer) const {
+    if (!visible) return;
+
+    SDL_BlendMode oldMode;
+    SDL_GetRenderDrawBlendMode(renderer, &oldMode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    SDL_Rect panel = {GRAPH_RECT.x - 5, GRAPH_RECT.y - 5, GRAPH_RECT.w + 10, GRAPH_RECT.h + 95};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(renderer, &panel);
+
+    // One column per frame, phases stacked bottom-up, then the rest of the
+    // frame (pacing) as a grey cap
+    const float pxPerMs = GRAPH_RECT.h / GRAPH_MAX_MS;
+    const int bottom = GRAPH_RECT.y + GRAPH_RECT.h;
+    float average[PHASE_COUNT] = {};
+    float averageFrame = 0.0f, worstFrame = 0.0f;
+
+    for (int i = 0; i < count; ++i) {
+        const Sample& s = sample(i);
+        int x = GRAPH_RECT.x + i;
+        int y = bottom;
+        float stacked = 0.0f;
+
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            stacked += s.phaseMs[p];
+            int top = std::max(GRAPH_RECT.y, bottom - int(stacked * pxPerMs));
+            if (top < y) {
+                SDL_SetRenderDrawColor(renderer, PHASE_COLORS[p].r, PHASE_COLORS[p].g, PHASE_COLORS[p].b, 255);
+                SDL_RenderDrawLine(renderer, x, y - 1, x, top);
+                y = top;
+            }
+            average[p] += s.phaseMs[p];
+        }
+
+        int frameTop = std::max(GRAPH_RECT.y, bottom - int(s.frameMs * pxPerMs));
+        if (frameTop < y) {
+            SDL_SetRenderDrawColor(renderer, 110, 110, 110, 255);
+            SDL_RenderDrawLine(renderer, x, y - 1, x, frameTop);
+        }
+
+        averageFrame += s.frameMs;
+        worstFrame = std::max(worstFrame, s.frameMs);
+    }
+
+    // Target frame time
+    float target = 1000.0f / FrameScheduler::targetHz();
+    int targetY = bottom - int(target * pxPerMs);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 120);
+    SDL_RenderDrawLine(renderer, GRAPH_RECT.x, targetY, GRAPH_RECT.x + GRAPH_RECT.w, targetY);
+
+    SDL_SetRenderDrawBlendMode(renderer, oldMode);
+
+    TTF_Font* font = FontRegistry::instance().get("arial.ttf", 14);
+    if (!font || count == 0) return;
+
+    char line[64];
+    int textY = bottom + 5;
+    std::snprintf(line, sizeof line, "frame %.2f ms avg, %.2f ms worst", averageFrame / count, worstFrame);
+    drawText(renderer, font, line, {255, 255, 255, 255}, GRAPH_RECT.x, textY);
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        textY += 18;
+        std::snprintf(line, sizeof line, "%-8s %.2f ms", PHASE_NAMES[p], average[p] / count);
+        drawText(renderer, font, line, PHASE_COLORS[p], GRAPH_RECT.x, textY);
+    }
+}
@@ -0,0 +1,73 @@
+// common/frame_profiler.h
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <string>
+
+// ----------------------------------------------------
+// FrameProfiler times each frame of the game loop and splits it into
+// phases using SDL's high-resolution counter:
+//
+//     profiler.beginFrame();
+//     ...poll events...          profiler.endPhase(FrameProfiler::EVENTS);
+//     ...update...               profiler.endPhase(FrameProfiler::UPDATE);
+//     ...draw...                 profiler.endPhase(FrameProfiler::RENDER);
+//     SDL_RenderPresent(...);    profiler.endPhase(FrameProfiler::PRESENT);
+//     frame.endFrame();
+//     profiler.endFrame();       // whole frame, pacing included
+//
+// The last HISTORY frames are kept in a ring buffer. F3 toggles a graph of
+// them over the game, F4 writes them to frame_profile.csv. While hidden it
+// only reads the counter a few times per frame.
+// ----------------------------------------------------
+class FrameProfiler {
+public:
+    enum Phase { EVENTS, UPDATE, RENDER, PRESENT, PHASE_COUNT };
+
+    static const int HISTORY = 240;
+    static const SDL_Keycode TOGGLE_KEY = SDLK_F3;
+    static const SDL_Keycode DUMP_KEY = SDLK_F4;
+
+    struct Sample {
+        float phaseMs[PHASE_COUNT];
+        float frameMs;
+    };
+
+    static FrameProfiler& instance();
+
+    void beginFrame();
+    void endPhase(Phase phase);
+    void endFrame();
+
+    // Handles the hotkeys; returns true if the event was one of them
+    bool handleEvent(const SDL_Event& e);
+
+    bool isVisible() const { return visible; }
+    void setVisible(bool show) { visible = show; }
+
+    // Draws the overlay if it is visible; call before SDL_RenderPresent
+    void draw(SDL_Renderer* renderer) const;
+
+    // Oldest frame first; returns false if the file cannot be written
+    bool dumpCsv(const std::string& path) const;
+
+    // Frames recorded so far (at most HISTORY) and the i-th oldest of them
+    int sampleCount() const { return count; }
+    const Sample& sample(int i) const;
+
+private:
+    FrameProfiler();
+
+    Sample history[HISTORY];
+    int next = 0;
+    int count = 0;
+
+    Sample current;
+    Uint64 frameStart = 0;
+    Uint64 phaseStart = 0;
+    double msPerTick;
+    bool visible = false;
+};
+
+#endif // FRAME_PROFILER_H
@@ -0,0 +1,85 @@
+// common/frame_scheduler.cpp
+#include "frame_scheduler.h"
+
+// Longest frame fed to the simulation; anything slower (a blocking popup,
+// a dragged window) is dropped instead of replayed as a burst of steps
+static const double MAX_FRAME_SECONDS = 0.25;
+
+// SDL_Delay can overshoot by a millisecond or two; spin for the remainder
+static const double SPIN_MS = 2.0;
+
+static int configuredHz = FrameScheduler::DEFAULT_TARGET_HZ;
+static bool configuredVsync = false;
+static double gameClockSeconds = 0.0;
+
+void FrameScheduler::configure(int targetHz, bool vsync) {
+    configuredHz = targetHz > 0 ? targetHz : DEFAULT_TARGET_HZ;
+    configuredVsync = vsync;
+}
+
+int FrameScheduler::targetHz() {
+    return configuredHz;
+}
+
+bool FrameScheduler::vsyncEnabled() {
+    return configuredVsync;
+}
+
+Uint32 FrameScheduler::gameTicks() {
+    return static_cast<Uint32>(gameClockSeconds * 1000.0);
+}
+
+bool FrameScheduler::waitForEvent(int timeoutMs) {
+    // A null event makes SDL peek instead of dequeuing
+    return SDL_WaitEventTimeout(nullptr, timeoutMs > 0 ? timeoutMs : 1) == 1;
+}
+
+FrameScheduler::FrameScheduler(double stepSeconds) : stepLength(stepSeconds) {}
+
+void FrameScheduler::beginFrame() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    beginFrame(frameStart ? double(now - frameStart) / SDL_GetPerformanceFrequency() : 0.0);
+}
+
+void FrameScheduler::beginFrame(double elapsedSeconds) {
+    elapsed = elapsedSeconds;
+
+    // The clock keeps real time across idle waits; only the simulation is clamped
+    gameClockSeconds += elapsed;
+    frameTime = elapsed > MAX_FRAME_SECONDS ? MAX_FRAME_SECONDS : elapsed;
+    accumulator += frameTime;
+    frameStart = SDL_GetPerformanceCounter();
+}
+
+bool FrameScheduler::step() {
+    if (accumulator < stepLength) return false;
+    accumulator -= stepLength;
+    return true;
+}
+
+void FrameScheduler::endFrame() {
+    if (configuredVsync) return;
+
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 period = frequency / configuredHz;
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Deadlines advance by whole periods so rounding never accumulates;
+    // after a long stall, restart from this frame instead of catching up
+    if (deadline == 0 || now > deadline + period) deadline = frameStart ? frameStart : now;
+    deadline += period;
+
+    while (now < deadline) {
+        double remainingMs = double(deadline - now) * 1000.0 / frequency;
+        if (remainingMs > SPIN_MS) SDL_Delay(static_cast<Uint32>(remainingMs - SPIN_MS));
+        now = SDL_GetPerformanceCounter();
+    }
+}
+
+void FrameScheduler::reset() {
+    accumulator = 0.0;
+    frameTime = 0.0;
+    elapsed = 0.0;
+    frameStart = 0;
+    deadline = 0;
+}
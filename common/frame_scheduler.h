@@ -0,0 +1,81 @@
+// common/frame_scheduler.h
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <SDL2/SDL.h>
+
+// ----------------------------------------------------
+// FrameScheduler paces a game loop and feeds it a fixed simulation step.
+//
+//     FrameScheduler frame;
+//     while (running) {
+//         frame.beginFrame();
+//         ...poll events...
+//         while (frame.step()) simulate(frame.stepSeconds());
+//         draw(frame.alpha());       // blend previous and current state
+//         SDL_RenderPresent(renderer);
+//         frame.endFrame();          // wait for the next frame slot
+//     }
+//
+// With vsync on, SDL_RenderPresent already blocks and endFrame() does not
+// wait. Otherwise it sleeps through most of the frame and spins the last
+// couple of milliseconds, since SDL_Delay alone overshoots.
+// ----------------------------------------------------
+class FrameScheduler {
+public:
+    static const int DEFAULT_TARGET_HZ = 60;
+    static const int IDLE_WAKE_MS = 1000;
+    static constexpr double DEFAULT_STEP = 1.0 / 120.0;
+
+    // Process-wide pacing, set once from the command line in main()
+    static void configure(int targetHz, bool vsync);
+    static int targetHz();
+    static bool vsyncEnabled();
+
+    // For render-on-demand screens: sleeps until an event is queued (it is
+    // left in the queue for SDL_PollEvent) or timeoutMs passes.
+    // Returns true if an event is waiting.
+    static bool waitForEvent(int timeoutMs = IDLE_WAKE_MS);
+
+    explicit FrameScheduler(double stepSeconds = DEFAULT_STEP);
+
+    // Measures the time since the previous frame and banks it for step()
+    void beginFrame();
+
+    // Same, with the frame's length supplied instead of measured (replays
+    // and the benchmark feed recorded or fixed times through here)
+    void beginFrame(double elapsedSeconds);
+
+    // True while a whole simulation step is banked; consumes it
+    bool step();
+
+    // Blocks until the next frame slot (no-op with vsync)
+    void endFrame();
+
+    // Drops banked time, e.g. after the loop was blocked by a popup
+    void reset();
+
+    double stepSeconds() const { return stepLength; }
+    double frameSeconds() const { return frameTime; }
+
+    // Length of this frame before clamping; what a recording stores
+    double elapsedSeconds() const { return elapsed; }
+
+    // Game time in milliseconds, advanced by every beginFrame(). Scene
+    // timers read this instead of SDL_GetTicks() so a replay sees the
+    // same clock as the session it was recorded from.
+    static Uint32 gameTicks();
+
+    // How far the banked time is into the next step, for interpolation
+    float alpha() const { return static_cast<float>(accumulator / stepLength); }
+
+private:
+    double stepLength;
+    double accumulator = 0.0;
+    double frameTime = 0.0;
+    double elapsed = 0.0;
+    Uint64 frameStart = 0;
+    Uint64 deadline = 0;
+};
+
+#endif // FRAME_SCHEDULER_H
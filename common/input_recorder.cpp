@@ -0,0 +1,263 @@
+// common/input_recorder.cpp
+#include "input_recorder.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Zigzag keeps small negative numbers small: 0, -1, 1, -2 -> 0, 1, 2, 3
+static void putSigned(std::vector<uint8_t>& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Window events are recorded because focus loss releases held keys
+static bool isRecorded(Uint32 type) {
+    switch (type) {
+        case SDL_QUIT:
+        case SDL_WINDOWEVENT:
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_TEXTINPUT:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const std::string& path, uint64_t seed) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "InputRecorder: cannot write " << path << std::endl;
+        return false;
+    }
+
+    buffer.assign(REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    buffer.push_back(REPLAY_VERSION);
+    putVarint(buffer, seed);
+    flush();
+    return true;
+}
+
+void InputRecorder::close() {
+    if (!file.is_open()) return;
+    flush();
+    file.close();
+}
+
+void InputRecorder::beginFrame(double elapsedSeconds) {
+    frameMicros = static_cast<uint64_t>(elapsedSeconds * 1e6 + 0.5);
+    frameEvents = 0;
+    frameBytes.clear();
+}
+
+void InputRecorder::record(const SDL_Event& e) {
+    if (!file.is_open() || !isRecorded(e.type)) return;
+
+    putVarint(frameBytes, e.type);
+    putSigned(frameBytes, int64_t(e.common.timestamp) - int64_t(lastTimestamp));
+    lastTimestamp = e.common.timestamp;
+
+    switch (e.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            putVarint(frameBytes, static_cast<uint64_t>(e.key.keysym.scancode));
+            putSigned(frameBytes, e.key.keysym.sym);
+            putVarint(frameBytes, e.key.keysym.mod);
+            putVarint(frameBytes, e.key.repeat);
+            break;
+        case SDL_TEXTINPUT: {
+            size_t length = strnlen(e.text.text, sizeof(e.text.text) - 1);
+            putVarint(frameBytes, length);
+            frameBytes.insert(frameBytes.end(), e.text.text, e.text.text + length);
+            break;
+        }
+        case SDL_MOUSEMOTION:
+            putSigned(frameBytes, e.motion.x - lastMouseX);
+            putSigned(frameBytes, e.motion.y - lastMouseY);
+            putVarint(frameBytes, e.motion.state);
+            lastMouseX = e.motion.x;
+            lastMouseY = e.motion.y;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            putSigned(frameBytes, e.button.x - lastMouseX);
+            putSigned(frameBytes, e.button.y - lastMouseY);
+            putVarint(frameBytes, e.button.button);
+            putVarint(frameBytes, e.button.clicks);
+            lastMouseX = e.button.x;
+            lastMouseY = e.button.y;
+            break;
+        case SDL_MOUSEWHEEL:
+            putSigned(frameBytes, e.wheel.x);
+            putSigned(frameBytes, e.wheel.y);
+            break;
+        case SDL_WINDOWEVENT:
+            putVarint(frameBytes, e.window.event);
+            putSigned(frameBytes, e.window.data1);
+            putSigned(frameBytes, e.window.data2);
+            break;
+        default:
+            break;
+    }
+    ++frameEvents;
+}
+
+void InputRecorder::endFrame() {
+    if (!file.is_open()) return;
+
+    putVarint(buffer, frameMicros);
+    putVarint(buffer, frameEvents);
+    buffer.insert(buffer.end(), frameBytes.begin(), frameBytes.end());
+    if (++pendingFrames >= FLUSH_FRAMES) flush();
+}
+
+void InputRecorder::flush() {
+    if (!buffer.empty()) file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    file.flush();
+    buffer.clear();
+    pendingFrames = 0;
+}
+
+bool InputReplay::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "InputReplay: cannot read " << path << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(REPLAY_MAGIC) + 1 ||
+        std::memcmp(data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+        data[sizeof(REPLAY_MAGIC)] != REPLAY_VERSION) {
+        std::cerr << "InputReplay: " << path << " is not a version "
+                  << int(REPLAY_VERSION) << " recording" << std::endl;
+        data.clear();
+        return false;
+    }
+
+    cursor = sizeof(REPLAY_MAGIC) + 1;
+    if (!readVarint(sessionSeed)) {
+        std::cerr << "InputReplay: " << path << " has a truncated header" << std::endl;
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool InputReplay::nextFrame(double& elapsedSeconds, std::vector<SDL_Event>& events) {
+    events.clear();
+
+    uint64_t micros = 0, count = 0;
+    if (!readVarint(micros) || !readVarint(count)) return false;
+    elapsedSeconds = micros / 1e6;
+
+    for (uint64_t i = 0; i < count; ++i) {
+        SDL_Event e;
+        if (!readEvent(e)) {
+            std::cerr << "InputReplay: recording ends mid-frame after " << frameCount << " frames" << std::endl;
+            return false;
+        }
+        events.push_back(e);
+    }
+    ++frameCount;
+    return true;
+}
+
+bool InputReplay::readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && cursor < data.size(); shift += 7) {
+        uint8_t byte = data[cursor++];
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool InputReplay::readSigned(int64_t& value) {
+    uint64_t raw;
+    if (!readVarint(raw)) return false;
+    value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+bool InputReplay::readEvent(SDL_Event& e) {
+    std::memset(&e, 0, sizeof(e));
+
+    uint64_t type, a, b;
+    int64_t delta, x, y;
+    if (!readVarint(type) || !readSigned(delta)) return false;
+    e.type = static_cast<Uint32>(type);
+    lastTimestamp = static_cast<Uint32>(lastTimestamp + delta);
+    e.common.timestamp = lastTimestamp;
+
+    switch (e.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP: {
+            int64_t sym;
+            if (!readVarint(a) || !readSigned(sym) || !readVarint(b)) return false;
+            e.key.keysym.scancode = static_cast<SDL_Scancode>(a);
+            e.key.keysym.sym = static_cast<SDL_Keycode>(sym);
+            e.key.keysym.mod = static_cast<Uint16>(b);
+            if (!readVarint(a)) return false;
+            e.key.repeat = static_cast<Uint8>(a);
+            e.key.state = e.type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+            return true;
+        }
+        case SDL_TEXTINPUT:
+            if (!readVarint(a) || a >= sizeof(e.text.text) || data.size() - cursor < a) return false;
+            std::memcpy(e.text.text, data.data() + cursor, a);
+            cursor += a;
+            return true;
+        case SDL_MOUSEMOTION:
+            if (!readSigned(x) || !readSigned(y) || !readVarint(a)) return false;
+            e.motion.x = lastMouseX + int(x);
+            e.motion.y = lastMouseY + int(y);
+            e.motion.xrel = int(x);
+            e.motion.yrel = int(y);
+            e.motion.state = static_cast<Uint32>(a);
+            lastMouseX = e.motion.x;
+            lastMouseY = e.motion.y;
+            return true;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            if (!readSigned(x) || !readSigned(y) || !readVarint(a) || !readVarint(b)) return false;
+            e.button.x = lastMouseX + int(x);
+            e.button.y = lastMouseY + int(y);
+            e.button.button = static_cast<Uint8>(a);
+            e.button.clicks = static_cast<Uint8>(b);
+            e.button.state = e.type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+            lastMouseX = e.button.x;
+            lastMouseY = e.button.y;
+            return true;
+        case SDL_MOUSEWHEEL:
+            if (!readSigned(x) || !readSigned(y)) return false;
+            e.wheel.x = int(x);
+            e.wheel.y = int(y);
+            return true;
+        case SDL_WINDOWEVENT:
+            if (!readVarint(a) || !readSigned(x) || !readSigned(y)) return false;
+            e.window.event = static_cast<Uint8>(a);
+            e.window.data1 = int(x);
+            e.window.data2 = int(y);
+            return true;
+        case SDL_QUIT:
+            return true;
+        default:
+            return false;
+    }
+}
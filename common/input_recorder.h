@@ -0,0 +1,90 @@
+// common/input_recorder.h
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------
+// Layout of a .errp input recording. Every integer is a LEB128 varint;
+// signed values are zigzag-encoded first.
+//   header: "ERRP", version byte, session seed
+//   frame:  elapsed microseconds, event count, events
+//   event:  type, timestamp delta from the previous event, then fields:
+//     - key down/up:     scancode, keycode, mod, repeat
+//     - text input:      byte length, UTF-8 bytes
+//     - mouse motion:    x and y delta from the last mouse position, buttons
+//     - mouse button:    x and y delta, button, clicks
+//     - mouse wheel:     x, y
+//     - window:          window event id, data1, data2
+//     - quit:            nothing
+// Other event types are not recorded; nothing in the game reads them.
+// ----------------------------------------------------
+static const char REPLAY_MAGIC[4] = {'E', 'R', 'R', 'P'};
+static const uint8_t REPLAY_VERSION = 1;
+
+// ----------------------------------------------------
+// InputRecorder writes the events GameManager dispatches, grouped by
+// frame with each frame's measured length. Frames are buffered and
+// written out every FLUSH_FRAMES, so recording costs no I/O per frame.
+// ----------------------------------------------------
+class InputRecorder {
+public:
+    ~InputRecorder();
+
+    bool open(const std::string& path, uint64_t seed);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    void beginFrame(double elapsedSeconds);
+    void record(const SDL_Event& e);
+    void endFrame();
+
+    static const int FLUSH_FRAMES = 60;
+
+private:
+    void flush();
+
+    std::ofstream file;
+    std::vector<uint8_t> buffer;     // completed frames not yet written
+    std::vector<uint8_t> frameBytes; // events of the current frame
+    uint64_t frameMicros = 0;
+    size_t frameEvents = 0;
+    int pendingFrames = 0;
+    Uint32 lastTimestamp = 0;
+    int lastMouseX = 0, lastMouseY = 0;
+};
+
+// ----------------------------------------------------
+// InputReplay loads a whole recording up front and hands it back one
+// frame at a time. Events come back with the fields the game reads
+// filled in and the rest zeroed.
+// ----------------------------------------------------
+class InputReplay {
+public:
+    bool open(const std::string& path);
+
+    uint64_t seed() const { return sessionSeed; }
+    int framesRead() const { return frameCount; }
+
+    // False once the recording is exhausted (or truncated)
+    bool nextFrame(double& elapsedSeconds, std::vector<SDL_Event>& events);
+
+private:
+    bool readVarint(uint64_t& value);
+    bool readSigned(int64_t& value);
+    bool readEvent(SDL_Event& e);
+
+    std::vector<uint8_t> data;
+    size_t cursor = 0;
+    uint64_t sessionSeed = 0;
+    int frameCount = 0;
+    Uint32 lastTimestamp = 0;
+    int lastMouseX = 0, lastMouseY = 0;
+};
+
+#endif // INPUT_RECORDER_H
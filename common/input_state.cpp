@@ -0,0 +1,25 @@
+// common/input_state.cpp
+#include "input_state.h"
+
+InputState& InputState::instance() {
+    static InputState state;
+    return state;
+}
+
+void InputState::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) {
+        SDL_Scancode code = e.key.keysym.scancode;
+        if (code >= 0 && code < SDL_NUM_SCANCODES) keys[code] = (e.type == SDL_KEYDOWN);
+    } else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_FOCUS_LOST) {
+        // SDL releases keys on focus loss without sending KEYUPs
+        reset();
+    }
+}
+
+bool InputState::isKeyDown(SDL_Scancode code) const {
+    return code >= 0 && code < SDL_NUM_SCANCODES && keys[code];
+}
+
+void InputState::reset() {
+    for (bool& key : keys) key = false;
+}
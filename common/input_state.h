@@ -0,0 +1,30 @@
+// common/input_state.h
+#ifndef INPUT_STATE_H
+#define INPUT_STATE_H
+
+#include <SDL2/SDL.h>
+
+// ----------------------------------------------------
+// InputState is the keyboard state as seen through the game's own event
+// stream. GameManager feeds it every event it dispatches, live or
+// replayed, so scenes that poll held keys stay deterministic under
+// replay, which SDL_GetKeyboardState() would not.
+// ----------------------------------------------------
+class InputState {
+public:
+    static InputState& instance();
+
+    void handleEvent(const SDL_Event& e);
+
+    bool isKeyDown(SDL_Scancode code) const;
+
+    // Releases every key (focus lost, new session)
+    void reset();
+
+private:
+    InputState() = default;
+
+    bool keys[SDL_NUM_SCANCODES] = {};
+};
+
+#endif // INPUT_STATE_H
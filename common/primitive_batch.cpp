@@ -0,0 +1,85 @@
+// common/primitive_batch.cpp
+#include "primitive_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static const int MIN_CIRCLE_SEGMENTS = 12;
+static const int MAX_CIRCLE_SEGMENTS = 64;
+
+PrimitiveBatch::PrimitiveBatch(SDL_Renderer* renderer, SDL_BlendMode blend)
+    : renderer(renderer), blend(blend) {}
+
+void PrimitiveBatch::setBlendMode(SDL_BlendMode mode) {
+    if (mode == blend) return;
+    flush();
+    blend = mode;
+}
+
+int PrimitiveBatch::addVertex(float x, float y, SDL_Color color) {
+    SDL_Vertex v;
+    v.position = {x, y};
+    v.color = color;
+    v.tex_coord = {0.0f, 0.0f};
+    vertices.push_back(v);
+    return static_cast<int>(vertices.size()) - 1;
+}
+
+void PrimitiveBatch::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    fillRect(float(rect.x), float(rect.y), float(rect.w), float(rect.h), color);
+}
+
+void PrimitiveBatch::fillRect(float x, float y, float w, float h, SDL_Color color) {
+    if (w <= 0.0f || h <= 0.0f) return;
+
+    int first = addVertex(x, y, color);
+    addVertex(x + w, y, color);
+    addVertex(x + w, y + h, color);
+    addVertex(x, y + h, color);
+    indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+}
+
+void PrimitiveBatch::line(float x1, float y1, float x2, float y2, SDL_Color color, float thickness) {
+    float dx = x2 - x1, dy = y2 - y1;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    // Offset both ends by half the thickness along the normal
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+    int first = addVertex(x1 + nx, y1 + ny, color);
+    addVertex(x2 + nx, y2 + ny, color);
+    addVertex(x2 - nx, y2 - ny, color);
+    addVertex(x1 - nx, y1 - ny, color);
+    indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+}
+
+void PrimitiveBatch::fillCircle(float cx, float cy, float radius, SDL_Color color, int segments) {
+    if (radius <= 0.0f) return;
+    if (segments <= 0) segments = std::clamp(int(radius * 0.75f), MIN_CIRCLE_SEGMENTS, MAX_CIRCLE_SEGMENTS);
+
+    int center = addVertex(cx, cy, color);
+    const float step = 2.0f * float(M_PI) / segments;
+    for (int i = 0; i < segments; ++i)
+        addVertex(cx + radius * std::cos(i * step), cy + radius * std::sin(i * step), color);
+    for (int i = 0; i < segments; ++i)
+        indices.insert(indices.end(), {center, center + 1 + i, center + 1 + (i + 1) % segments});
+}
+
+void PrimitiveBatch::flush() {
+    if (indices.empty()) return;
+
+    // Untextured geometry is blended with the renderer's draw blend mode
+    SDL_BlendMode previous;
+    SDL_GetRenderDrawBlendMode(renderer, &previous);
+    SDL_SetRenderDrawBlendMode(renderer, blend);
+    if (SDL_RenderGeometry(renderer, nullptr, vertices.data(), int(vertices.size()),
+                           indices.data(), int(indices.size())) < 0) {
+        std::cerr << "PrimitiveBatch: SDL_RenderGeometry failed: " << SDL_GetError() << std::endl;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, previous);
+    ++calls;
+
+    vertices.clear();
+    indices.clear();
+}
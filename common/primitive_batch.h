@@ -0,0 +1,51 @@
+// common/primitive_batch.h
+#ifndef PRIMITIVE_BATCH_H
+#define PRIMITIVE_BATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// ----------------------------------------------------
+// PrimitiveBatch collects solid-colored rects, lines and circles as
+// triangles and draws them all with one SDL_RenderGeometry call, instead
+// of a SetRenderDrawColor + FillRect pair per shape:
+//
+//     batch.fillRect(cell, color);   // x200
+//     batch.flush();                 // one draw call
+//
+// Changing the blend mode flushes what is queued under the old one.
+// Nothing reaches the screen until flush(), so flush before drawing
+// anything (text, textures) that must appear on top of the batch.
+// ----------------------------------------------------
+class PrimitiveBatch {
+public:
+    explicit PrimitiveBatch(SDL_Renderer* renderer, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+    void setBlendMode(SDL_BlendMode mode);
+
+    void fillRect(const SDL_Rect& rect, SDL_Color color);
+    void fillRect(float x, float y, float w, float h, SDL_Color color);
+    void line(float x1, float y1, float x2, float y2, SDL_Color color, float thickness = 1.0f);
+
+    // segments = 0 picks a count from the radius
+    void fillCircle(float cx, float cy, float radius, SDL_Color color, int segments = 0);
+
+    // Draws everything queued and empties the batch
+    void flush();
+
+    bool empty() const { return indices.empty(); }
+
+    // Draw calls issued by flush() since construction; for the bench
+    int drawCalls() const { return calls; }
+
+private:
+    int addVertex(float x, float y, SDL_Color color);
+
+    SDL_Renderer* renderer;
+    SDL_BlendMode blend;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    int calls = 0;
+};
+
+#endif // PRIMITIVE_BATCH_H
@@ -0,0 +1,68 @@
+// common/rng.cpp
+#include "rng.h"
+
+static uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void Rng::reseed(uint64_t seed) {
+    for (uint64_t& word : s) word = splitmix64(seed);
+}
+
+// Lemire's multiply-shift; the retry only triggers on the sliver of
+// values that would bias the result
+uint32_t Rng::below(uint32_t bound) {
+    uint64_t m = (next() >> 32) * bound;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            m = (next() >> 32) * bound;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<uint32_t>(m >> 32);
+}
+
+void Rng::fillBelow(uint32_t bound, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = below(bound);
+}
+
+void Rng::fillUniform(float lo, float hi, float* out, size_t count) {
+    const float scale = (hi - lo) * (1.0f / 16777216.0f);
+    for (size_t i = 0; i < count; ++i) out[i] = lo + static_cast<float>(next() >> 40) * scale;
+}
+
+void Rng::jump() {
+    static const uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (uint64_t word : JUMP) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (uint64_t(1) << bit)) {
+                for (int i = 0; i < 4; ++i) t[i] ^= s[i];
+            }
+            next();
+        }
+    }
+    for (int i = 0; i < 4; ++i) s[i] = t[i];
+}
+
+RngService& RngService::instance() {
+    static RngService service;
+    return service;
+}
+
+void RngService::seed(uint64_t sessionSeed) {
+    seedValue = sessionSeed;
+    Rng base(sessionSeed);
+    for (Rng& stream : streams) {
+        stream = base;
+        base.jump();
+    }
+}
@@ -0,0 +1,81 @@
+// common/rng.h
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ----------------------------------------------------
+// Rng is a xoshiro256** generator: 32 bytes of state, a few cycles per
+// number, and unlike rand() it belongs to whoever holds it. Seeds are
+// expanded with splitmix64, so any 64-bit value (0 included) is a good
+// seed. Bounded draws are unbiased.
+// ----------------------------------------------------
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed);
+
+    uint64_t next() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, bound); bound must be > 0
+    uint32_t below(uint32_t bound);
+
+    // [lo, hi], both ends included
+    int range(int lo, int hi) { return lo + static_cast<int>(below(static_cast<uint32_t>(hi - lo) + 1)); }
+
+    // [0, 1) and [lo, hi)
+    float uniform() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+    float uniform(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+
+    // Batch forms of below() and uniform(lo, hi), for filling a wave of
+    // spawns or a bullet spread in one call
+    void fillBelow(uint32_t bound, uint32_t* out, size_t count);
+    void fillUniform(float lo, float hi, float* out, size_t count);
+
+    // Advances 2^128 draws; successive jumps give non-overlapping streams
+    void jump();
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];
+};
+
+// ----------------------------------------------------
+// RngService hands each minigame its own stream, all derived from the
+// one session seed main() picks (or reads from a recording). A stream
+// only advances when its own minigame draws from it, so what one game
+// does never changes another's sequence.
+// ----------------------------------------------------
+class RngService {
+public:
+    enum Stream { TETRIS, CIRCUIT, SHOOTER, MONSTER, STREAM_COUNT };
+
+    static RngService& instance();
+
+    // Restarts every stream from sessionSeed
+    void seed(uint64_t sessionSeed);
+    uint64_t sessionSeed() const { return seedValue; }
+
+    Rng& stream(Stream which) { return streams[which]; }
+
+private:
+    RngService() { seed(0); }
+
+    uint64_t seedValue = 0;
+    Rng streams[STREAM_COUNT];
+};
+
+#endif // RNG_H
@@ -0,0 +1,287 @@
+// common/run_log.cpp
+#include "run_log.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "durable_file.h"
+
+// Snapshot header; both files use native byte order, like assets.pak
+static const char SNAPSHOT_MAGIC[4] = {'E', 'R', 'R', 'L'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint64_t nextSeq;  // first seq not in this snapshot
+};
+
+// Record: seq (8), seconds (4), name length (1), name, FNV-1a checksum (4)
+static const size_t RECORD_FIXED_BYTES = 8 + 4 + 1 + 4;
+
+static uint32_t fnv1a(const unsigned char* bytes, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+static void encodeRecord(const RunRecord& run, std::vector<unsigned char>& out) {
+    size_t start = out.size();
+    uint8_t nameLength = static_cast<uint8_t>(std::strlen(run.name));
+    out.resize(start + RECORD_FIXED_BYTES + nameLength);
+    unsigned char* p = out.data() + start;
+    std::memcpy(p, &run.seq, 8);
+    std::memcpy(p + 8, &run.seconds, 4);
+    p[12] = nameLength;
+    std::memcpy(p + 13, run.name, nameLength);
+    uint32_t checksum = fnv1a(p, 13 + nameLength);
+    std::memcpy(p + 13 + nameLength, &checksum, 4);
+}
+
+// Decodes the record at offset; false if it is truncated or corrupt
+static bool decodeRecord(const std::vector<unsigned char>& in, size_t& offset, RunRecord& run) {
+    if (in.size() - offset < RECORD_FIXED_BYTES) return false;
+    const unsigned char* p = in.data() + offset;
+    uint8_t nameLength = p[12];
+    if (nameLength > RunRecord::MAX_NAME_BYTES || in.size() - offset < RECORD_FIXED_BYTES + nameLength) return false;
+
+    uint32_t checksum;
+    std::memcpy(&checksum, p + 13 + nameLength, 4);
+    if (checksum != fnv1a(p, 13 + nameLength)) return false;
+
+    std::memcpy(&run.seq, p, 8);
+    std::memcpy(&run.seconds, p + 8, 4);
+    std::memcpy(run.name, p + 13, nameLength);
+    run.name[nameLength] = '\0';
+    offset += RECORD_FIXED_BYTES + nameLength;
+    return true;
+}
+
+RunLog& RunLog::instance() {
+    static RunLog log;
+    return log;
+}
+
+void RunLog::remember(const RunRecord& run) {
+    runs.push_back(run);
+    if (best.size() < size_t(TOP_K)) {
+        best.push_back(run);
+        std::push_heap(best.begin(), best.end());
+    } else if (run < best.front()) {
+        std::pop_heap(best.begin(), best.end());
+        best.back() = run;
+        std::push_heap(best.begin(), best.end());
+    }
+}
+
+bool RunLog::open(const std::string& base, const std::string& legacyLeaderboard) {
+    std::lock_guard<std::mutex> writing(writeMutex);
+    basePath = base;
+    runs.clear();
+    best.clear();
+    sortedCount = 0;
+    nextSeq = 0;
+    logRecords = 0;
+
+    std::vector<unsigned char> bytes;
+    bool haveSnapshot = readFile(base + ".dat", bytes);
+    if (haveSnapshot) {
+        SnapshotHeader header;
+        if (bytes.size() < sizeof(header)) {
+            std::cerr << "RunLog: " << base << ".dat is truncated" << std::endl;
+            return false;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, SNAPSHOT_MAGIC, 4) != 0 || header.version != SNAPSHOT_VERSION) {
+            std::cerr << "RunLog: " << base << ".dat is not a version " << SNAPSHOT_VERSION << " run log" << std::endl;
+            return false;
+        }
+
+        runs.reserve(header.count + COMPACT_EVERY);
+        size_t offset = sizeof(header);
+        RunRecord run;
+        for (uint64_t i = 0; i < header.count; ++i) {
+            if (!decodeRecord(bytes, offset, run)) {
+                std::cerr << "RunLog: " << base << ".dat is corrupt after " << i << " runs" << std::endl;
+                break;
+            }
+            remember(run);
+        }
+        sortedCount = runs.size();  // snapshots are written in order
+        nextSeq = header.nextSeq;
+    }
+
+    bool haveLog = readFile(base + ".log", bytes);
+    if (haveLog) {
+        size_t offset = 0;
+        RunRecord run;
+        while (decodeRecord(bytes, offset, run)) {
+            if (run.seq < nextSeq) continue;  // already compacted
+            remember(run);
+            nextSeq = run.seq + 1;
+            ++logRecords;
+        }
+        if (offset < bytes.size()) {
+            std::cerr << "RunLog: dropping " << bytes.size() - offset << " torn bytes from " << base << ".log" << std::endl;
+            truncateFile(base + ".log", offset);
+        }
+    }
+
+    if (!haveSnapshot && !haveLog) return importLegacy(legacyLeaderboard);
+    return true;
+}
+
+bool RunLog::importLegacy(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return true;  // nothing to migrate
+
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t comma = line.rfind(',');
+        if (comma == std::string::npos) continue;
+        RunRecord run;
+        try {
+            run.seconds = std::stof(line.substr(comma + 1));
+        } catch (...) {
+            std::cerr << "RunLog: skipping bad line in " << path << ": " << line << std::endl;
+            continue;
+        }
+        std::string name = line.substr(0, std::min(comma, RunRecord::MAX_NAME_BYTES));
+        std::memcpy(run.name, name.data(), name.size());
+        run.seq = nextSeq++;
+        remember(run);
+    }
+    std::cout << "RunLog: imported " << runs.size() << " runs from " << path << std::endl;
+    return compactLocked();
+}
+
+bool RunLog::append(const std::string& name, float seconds) {
+    std::vector<RunRecord> batch(1);
+    batch[0].seconds = seconds;
+    std::memcpy(batch[0].name, name.data(), std::min(name.size(), RunRecord::MAX_NAME_BYTES));
+    return appendBatch(batch);
+}
+
+bool RunLog::appendBatch(std::vector<RunRecord>& batch) {
+    std::lock_guard<std::mutex> writing(writeMutex);
+    // Not open (a replay): the run is neither written nor shown
+    if (!isOpen()) return false;
+
+    // Only appends hand out sequence numbers, and writeMutex serializes
+    // them. A failed append still uses its numbers up: some of its bytes
+    // may have reached the log, and a later run must not reuse their seq.
+    std::vector<unsigned char> bytes;
+    {
+        std::lock_guard<std::mutex> lock(memoryMutex);
+        for (RunRecord& run : batch) run.seq = nextSeq++;
+    }
+    for (const RunRecord& run : batch) encodeRecord(run, bytes);
+
+    if (!appendFile(basePath + ".log", bytes.data(), bytes.size(), syncAppends)) {
+        std::cerr << "RunLog: cannot append to " << basePath << ".log" << std::endl;
+        return false;
+    }
+
+    // Shown only once on disk, so the board never has a run a restart would lose
+    {
+        std::lock_guard<std::mutex> lock(memoryMutex);
+        for (const RunRecord& run : batch) remember(run);
+    }
+    logRecords += batch.size();
+    if (logRecords >= COMPACT_EVERY) return compactLocked();
+    return true;
+}
+
+bool RunLog::compact() {
+    std::lock_guard<std::mutex> writing(writeMutex);
+    return compactLocked();
+}
+
+bool RunLog::compactLocked() {
+    if (!isOpen()) return false;
+
+    // Readers wait only for a copy of the table; the sort and the encoding
+    // run on it outside memoryMutex
+    size_t sorted = 0;
+    SnapshotHeader header;
+    {
+        std::lock_guard<std::mutex> lock(memoryMutex);
+        snapshotRuns.assign(runs.begin(), runs.end());
+        sorted = sortedCount;
+        header.nextSeq = nextSeq;
+    }
+    auto middle = snapshotRuns.begin() + sorted;
+    std::sort(middle, snapshotRuns.end());
+    std::inplace_merge(snapshotRuns.begin(), middle, snapshotRuns.end());
+
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.version = SNAPSHOT_VERSION;
+    header.count = snapshotRuns.size();
+
+    std::vector<unsigned char> bytes(sizeof(header));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    bytes.reserve(sizeof(header) + snapshotRuns.size() * (RECORD_FIXED_BYTES + 12));
+    for (const RunRecord& run : snapshotRuns) encodeRecord(run, bytes);
+
+    // Appends wait on writeMutex, which is held, so runs still holds the
+    // same records; if no reader has sorted them meanwhile, take the
+    // sorted copy in their place
+    {
+        std::lock_guard<std::mutex> lock(memoryMutex);
+        if (sortedCount < runs.size()) {
+            runs.swap(snapshotRuns);
+            sortedCount = runs.size();
+        }
+    }
+
+    if (!writeFileAtomic(basePath + ".dat", bytes.data(), bytes.size())) return false;
+
+    // The snapshot holds everything now; an empty log can be recreated
+    truncateFile(basePath + ".log", 0);
+    logRecords = 0;
+    return true;
+}
+
+std::vector<RunRecord> RunLog::top() const {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    std::vector<RunRecord> result = best;
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void RunLog::sortLocked() {
+    if (sortedCount < runs.size()) {
+        auto middle = runs.begin() + sortedCount;
+        std::sort(middle, runs.end());
+        std::inplace_merge(runs.begin(), middle, runs.end());
+        sortedCount = runs.size();
+    }
+}
+
+const std::vector<RunRecord>& RunLog::sortedRuns() {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    sortLocked();
+    return runs;
+}
+
+size_t RunLog::page(size_t first, size_t count, std::vector<RunRecord>& out) {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    sortLocked();
+    out.clear();
+    if (first >= runs.size()) return 0;
+    size_t last = std::min(runs.size(), first + count);
+    out.assign(runs.begin() + first, runs.begin() + last);
+    return out.size();
+}
+
+size_t RunLog::rankOf(const RunRecord& run) {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    sortLocked();  // a no-op for every run of a batch after the first
+    return size_t(std::lower_bound(runs.begin(), runs.end(), run) - runs.begin()) + 1;
+}
+
+size_t RunLog::size() const {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    return runs.size();
+}
@@ -0,0 +1,109 @@
+// common/run_log.h
+#ifndef RUN_LOG_H
+#define RUN_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------
+// One completed escape. seq numbers runs in the order they were
+// recorded; it breaks ties between equal times and tells the log which
+// records a snapshot already holds.
+// ----------------------------------------------------
+struct RunRecord {
+    static constexpr size_t MAX_NAME_BYTES = 23;
+
+    uint64_t seq = 0;
+    float seconds = 0.0f;
+    char name[MAX_NAME_BYTES + 1] = {};
+
+    // Faster first; the earlier run wins a tie
+    bool operator<(const RunRecord& other) const {
+        return seconds != other.seconds ? seconds < other.seconds : seq < other.seq;
+    }
+};
+
+// ----------------------------------------------------
+// RunLog keeps every completed run, on disk as two files:
+//   <base>.dat  snapshot: header, then all runs fastest first
+//   <base>.log  runs recorded since the snapshot, appended one at a time
+// Records carry a checksum, so a record torn by a crash is detected and
+// cut off on the next load. Every COMPACT_EVERY appends the runs are
+// merged into a new snapshot written with writeFileAtomic(); a crash
+// between the rename and emptying the log is harmless because the
+// snapshot's nextSeq says which log records it already contains.
+//
+// The best TOP_K runs are kept in a bounded heap, so recording a run is
+// O(log K) and never sorts the whole table.
+//
+// In the game RunWriter does the appending on its own thread while the
+// leaderboard reads. Appends are serialized among themselves; readers
+// lock only the in-memory table, never across a write to disk.
+// ----------------------------------------------------
+class RunLog {
+public:
+    static const int TOP_K = 10;
+    static const size_t COMPACT_EVERY = 1024;
+
+    static RunLog& instance();
+
+    // Loads <base>.dat and <base>.log. On first use, imports the old
+    // leaderboard.txt (name,time lines) if there is one.
+    bool open(const std::string& base, const std::string& legacyLeaderboard = "leaderboard.txt");
+    bool isOpen() const { return !basePath.empty(); }
+
+    // Records a run (durably if sync is on); false if it could not be written
+    bool append(const std::string& name, float seconds);
+
+    // Records every run in batch (name and seconds set; seq is assigned
+    // here) with a single write and at most one fsync
+    bool appendBatch(std::vector<RunRecord>& batch);
+
+    // Rewrites the snapshot with every run and empties the log
+    bool compact();
+
+    // Fastest first, at most TOP_K
+    std::vector<RunRecord> top() const;
+
+    // Every run, fastest first. Sorts only what was recorded since the
+    // last call, then merges it in. The reference is only safe to hold
+    // while nothing is appending; other threads should use page().
+    const std::vector<RunRecord>& sortedRuns();
+
+    // Replaces out with up to count runs starting at rank first (0 is
+    // fastest); returns how many were copied
+    size_t page(size_t first, size_t count, std::vector<RunRecord>& out);
+
+    // Position of a recorded run on the board, 1 for the fastest
+    size_t rankOf(const RunRecord& run);
+
+    size_t size() const;
+
+    // fsync every append (default). The benchmark turns it off to
+    // measure the in-memory cost.
+    void setSyncOnAppend(bool sync) { syncAppends = sync; }
+
+private:
+    RunLog() = default;
+    void remember(const RunRecord& run);
+    bool importLegacy(const std::string& path);
+    void sortLocked();
+    bool compactLocked();
+
+    std::string basePath;
+    std::vector<RunRecord> runs;   // runs[0, sortedCount) is in order
+    size_t sortedCount = 0;
+    std::vector<RunRecord> best;   // max-heap of the TOP_K fastest
+    uint64_t nextSeq = 0;
+    size_t logRecords = 0;         // appended since the last snapshot
+    std::vector<RunRecord> snapshotRuns;  // compaction's copy of runs; kept for its capacity
+    bool syncAppends = true;
+
+    mutable std::mutex memoryMutex;  // runs, best, sortedCount, nextSeq
+    std::mutex writeMutex;           // one writer at a time, files, logRecords, snapshotRuns
+};
+
+#endif // RUN_LOG_H
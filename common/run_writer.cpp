@@ -0,0 +1,111 @@
+// common/run_writer.cpp
+#include "run_writer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Upper bound on how long a run waits in the queue if its wakeup is missed
+static const int WRITER_POLL_MS = 50;
+
+RunWriter& RunWriter::instance() {
+    // Never destroyed, like AssetLoader: a joinable std::thread in a static
+    // destructor would terminate the process
+    static RunWriter* writer = new RunWriter();
+    return *writer;
+}
+
+void RunWriter::start() {
+    if (writer.joinable()) return;
+    stopping = false;
+    writer = std::thread(&RunWriter::writerLoop, this);
+}
+
+void RunWriter::shutdown() {
+    if (!writer.joinable()) return;
+    stopping = true;
+    wake.notify_one();
+    writer.join();  // the writer empties the queue before it leaves
+}
+
+bool RunWriter::submit(const std::string& name, float seconds, Callback done) {
+    if (!writer.joinable()) return false;
+
+    Submission submission;
+    submission.run.seconds = seconds;
+    std::memcpy(submission.run.name, name.data(), std::min(name.size(), RunRecord::MAX_NAME_BYTES));
+    submission.done = std::move(done);
+    if (!submissions.tryPush(std::move(submission))) {
+        std::cerr << "RunWriter: queue full, run by " << name << " not recorded" << std::endl;
+        return false;
+    }
+    ++submitted;
+    wake.notify_one();
+    return true;
+}
+
+void RunWriter::flush() {
+    if (!writer.joinable()) return;
+    wake.notify_one();
+    std::unique_lock<std::mutex> lock(mutex);
+    while (written.load() < submitted)
+        drained.wait_for(lock, std::chrono::milliseconds(WRITER_POLL_MS));
+}
+
+bool RunWriter::pump() {
+    bool delivered = false;
+    Result result;
+    while (results.tryPop(result)) {
+        if (result.done) result.done(result.rank);
+        delivered = true;
+    }
+    return delivered;
+}
+
+void RunWriter::writerLoop() {
+    RunLog& log = RunLog::instance();
+    std::vector<RunRecord> batch;
+    std::vector<Callback> callbacks;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait_for(lock, std::chrono::milliseconds(WRITER_POLL_MS),
+                          [this] { return stopping.load() || !submissions.empty(); });
+        }
+
+        // Everything queued so far goes out in one append
+        batch.clear();
+        callbacks.clear();
+        Submission submission;
+        while (submissions.tryPop(submission)) {
+            batch.push_back(submission.run);
+            callbacks.push_back(std::move(submission.done));
+        }
+
+        if (!batch.empty()) {
+            bool ok = log.appendBatch(batch);
+
+            // On disk now: release flush() before waiting on pump()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                written += batch.size();
+            }
+            drained.notify_all();
+
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (!callbacks[i]) continue;
+                Result result;
+                result.rank = ok ? log.rankOf(batch[i]) : 0;
+                result.done = std::move(callbacks[i]);
+                // pump() runs every frame; nobody pumps once we are stopping
+                while (!results.tryPush(std::move(result)) && !stopping)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        // Leave only once a stop finds nothing left to write
+        if (stopping && submissions.empty()) return;
+    }
+}
@@ -0,0 +1,81 @@
+// common/run_writer.h
+#ifndef RUN_WRITER_H
+#define RUN_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "run_log.h"
+#include "spsc_queue.h"
+
+// ----------------------------------------------------
+// RunWriter records finished runs in RunLog from a background thread so
+// the game never waits on the disk. submit() drops the run into a
+// lock-free queue and returns at once; the writer drains whatever has
+// piled up and appends it as one batch with a single fsync. Results come
+// back through a second queue and are handed to their callbacks from
+// pump(), on the main thread like AssetLoader::pump().
+//
+// shutdown() writes out everything still queued before it returns; main()
+// calls it once GameManager::run() is done.
+//
+// submit() and pump() belong to the main thread; the writer is the only
+// other side of each queue.
+// ----------------------------------------------------
+class RunWriter {
+public:
+    // rank is the run's place on the board (1 is fastest), 0 if the run
+    // could not be written
+    using Callback = std::function<void(size_t rank)>;
+
+    static const size_t QUEUE_SIZE = 64;
+
+    static RunWriter& instance();
+
+    void start();
+
+    // Flushes the queue, then stops the thread. Undelivered callbacks are dropped.
+    void shutdown();
+
+    // Queues a run; false if the writer is not running or the queue is full
+    bool submit(const std::string& name, float seconds, Callback done = nullptr);
+
+    // Blocks until everything submitted so far is on disk
+    void flush();
+
+    // Main thread: runs the callbacks of runs that have landed.
+    // Returns true if any did.
+    bool pump();
+
+private:
+    struct Submission {
+        RunRecord run;
+        Callback done;
+    };
+
+    struct Result {
+        size_t rank = 0;
+        Callback done;
+    };
+
+    RunWriter() = default;
+    void writerLoop();
+
+    std::thread writer;
+    SpscQueue<Submission, QUEUE_SIZE> submissions;  // main -> writer
+    SpscQueue<Result, QUEUE_SIZE> results;          // writer -> main
+
+    // Only for sleeping; submit() never takes it, so a wakeup can be
+    // missed and the writer also polls every WRITER_POLL_MS
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    size_t submitted = 0;  // main thread only
+    std::atomic<size_t> written{0};
+    std::atomic<bool> stopping{false};
+};
+
+#endif // RUN_WRITER_H
@@ -0,0 +1,83 @@
+// common/scene.cpp
+#include "scene.h"
+
+void Scene::finish(bool success) {
+    if (finishing) return;
+    finishing = true;
+
+    SceneCallback callback = std::move(onFinish);
+    onFinish = nullptr;
+    owner->pop();
+    // Runs now, while this scene is still alive; anything it pushes is
+    // queued behind the pop above
+    if (callback) callback(success);
+}
+
+SceneStack::~SceneStack() {
+    pending.clear();
+    while (!scenes.empty()) popNow();
+}
+
+void SceneStack::push(std::unique_ptr<Scene> scene, SceneCallback onFinish) {
+    scene->onFinish = std::move(onFinish);
+    pending.push_back({Change::PUSH, std::move(scene)});
+}
+
+void SceneStack::pop() {
+    pending.push_back({Change::POP, nullptr});
+}
+
+void SceneStack::clear() {
+    pending.push_back({Change::CLEAR, nullptr});
+}
+
+void SceneStack::popNow() {
+    scenes.back()->exit();
+    scenes.pop_back();
+}
+
+bool SceneStack::applyPending() {
+    if (pending.empty()) return false;
+
+    // Changes made from exit()/enter() land in `pending` again; keep going
+    // until the stack settles
+    while (!pending.empty()) {
+        std::vector<Change> changes = std::move(pending);
+        pending.clear();
+
+        for (Change& change : changes) {
+            if (change.kind == Change::PUSH) {
+                if (!scenes.empty()) scenes.back()->pause();
+                change.scene->owner = this;
+                scenes.push_back(std::move(change.scene));
+                scenes.back()->enter();
+            } else if (change.kind == Change::POP) {
+                if (scenes.empty()) continue;
+                popNow();
+                if (!scenes.empty()) scenes.back()->resume();
+            } else {
+                while (!scenes.empty()) popNow();
+            }
+        }
+    }
+    return true;
+}
+
+void SceneStack::handleEvent(const SDL_Event& e) {
+    // Once a change is queued the rest of this frame's input belongs to
+    // whatever ends up on top, so drop it (no double-clicks into two doors)
+    if (!pending.empty()) return;
+    if (!scenes.empty() && !scenes.back()->finishing) scenes.back()->handleEvent(e);
+}
+
+void SceneStack::update(double dt) {
+    if (!scenes.empty() && !scenes.back()->finishing) scenes.back()->update(dt);
+}
+
+void SceneStack::render(SDL_Renderer* renderer, float alpha) {
+    if (scenes.empty()) return;
+
+    size_t first = scenes.size() - 1;
+    while (first > 0 && scenes[first]->isOverlay()) --first;
+    for (size_t i = first; i < scenes.size(); ++i) scenes[i]->render(renderer, alpha);
+}
@@ -0,0 +1,102 @@
+// common/scene.h
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class SceneStack;
+
+// Reports how a scene ended (won/solved/confirmed) to whoever pushed it
+using SceneCallback = std::function<void(bool success)>;
+
+// ----------------------------------------------------
+// Scene is one screen of the game: the menu, a floor, a minigame or a
+// popup. GameManager owns a single event loop and drives the scene on top
+// of its SceneStack; scenes underneath stay resident with all their state.
+// ----------------------------------------------------
+class Scene {
+public:
+    virtual ~Scene() = default;
+
+    // Pushed onto the stack / popped off it
+    virtual void enter() {}
+    virtual void exit() {}
+
+    // Another scene was pushed on top of this one / was popped off again
+    virtual void pause() {}
+    virtual void resume() {}
+
+    virtual void handleEvent(const SDL_Event& e) = 0;
+
+    // Advances the simulation by one fixed step of dt seconds
+    virtual void update(double dt) {}
+
+    // alpha is how far the frame is between the last two updates,
+    // for scenes that interpolate motion
+    virtual void render(SDL_Renderer* renderer, float alpha) = 0;
+
+    // Overlays are drawn on top of the scene underneath instead of
+    // replacing it (e.g. a message over a floor)
+    virtual bool isOverlay() const { return false; }
+
+    // 0 redraws every frame. Static screens return how long they can sleep
+    // between redraws; they are redrawn after any event as well.
+    virtual int redrawIntervalMs() const { return 0; }
+
+protected:
+    SceneStack& stack() const { return *owner; }
+
+    // Pops this scene and reports the outcome through its callback.
+    // Only the first call counts; the scene gets no more events or updates.
+    void finish(bool success = true);
+
+private:
+    SceneStack* owner = nullptr;
+    SceneCallback onFinish;
+    bool finishing = false;
+
+    friend class SceneStack;
+};
+
+// ----------------------------------------------------
+// SceneStack holds the live scenes, top last. Changes requested while a
+// scene is running (push/pop/clear) are queued and applied between frames
+// by applyPending(), so a scene can safely pop itself from handleEvent().
+// ----------------------------------------------------
+class SceneStack {
+public:
+    ~SceneStack();
+
+    void push(std::unique_ptr<Scene> scene, SceneCallback onFinish = nullptr);
+    void pop();
+    void clear();
+
+    // Performs the queued changes; returns true if the stack changed
+    bool applyPending();
+
+    bool empty() const { return scenes.empty(); }
+    Scene* top() const { return scenes.empty() ? nullptr : scenes.back().get(); }
+
+    // Events and updates go to the top scene only
+    void handleEvent(const SDL_Event& e);
+    void update(double dt);
+
+    // Draws the top scene and any scenes showing through its overlays
+    void render(SDL_Renderer* renderer, float alpha);
+
+private:
+    struct Change {
+        enum Kind { PUSH, POP, CLEAR } kind;
+        std::unique_ptr<Scene> scene;
+    };
+
+    void popNow();
+
+    std::vector<std::unique_ptr<Scene>> scenes;
+    std::vector<Change> pending;
+};
+
+#endif // SCENE_H
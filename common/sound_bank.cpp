@@ -0,0 +1,44 @@
+// common/sound_bank.cpp
+#include "sound_bank.h"
+#include "asset_pack.h"
+#include <iostream>
+
+SoundBank& SoundBank::instance() {
+    static SoundBank bank;
+    return bank;
+}
+
+void SoundBank::preload(const std::vector<std::string>& paths) {
+    for (const auto& path : paths) get(path);
+}
+
+Mix_Chunk* SoundBank::get(const std::string& path) {
+    auto it = chunks.find(path);
+    if (it != chunks.end()) return it->second;
+
+    Mix_Chunk* chunk = AssetPack::instance().createChunk(path);
+    if (!chunk) chunk = Mix_LoadWAV(path.c_str());
+    if (!chunk) std::cerr << "Failed to load sound " << path << ": " << Mix_GetError() << std::endl;
+    chunks.emplace(path, chunk);
+    return chunk;
+}
+
+void SoundBank::adopt(const std::string& path, Mix_Chunk* chunk) {
+    auto it = chunks.find(path);
+    if (it == chunks.end()) {
+        chunks.emplace(path, chunk);
+    } else if (!it->second) {
+        it->second = chunk;  // a synchronous get() failed earlier; keep the good copy
+    } else {
+        Mix_FreeChunk(chunk);
+    }
+}
+
+void SoundBank::clear() {
+    // A chunk must not be freed while a channel is still mixing it
+    Mix_HaltChannel(-1);
+    for (auto& entry : chunks) {
+        if (entry.second) Mix_FreeChunk(entry.second);
+    }
+    chunks.clear();
+}
@@ -0,0 +1,45 @@
+// common/sound_bank.h
+#ifndef SOUND_BANK_H
+#define SOUND_BANK_H
+
+#include <SDL2/SDL_mixer.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------
+// SoundBank decodes each sound effect once per process.
+// Mix_LoadWAV converts to the mixer's output format, so the chunks kept
+// here are ready to play; floors and minigames borrow them instead of
+// decoding the MP3 again on every entry.
+// Chunks handed out are borrowed: callers must not Mix_FreeChunk them.
+// ----------------------------------------------------
+class SoundBank {
+public:
+    static SoundBank& instance();
+
+    // Decode a list of effects up front, at startup
+    void preload(const std::vector<std::string>& paths);
+
+    // Borrowed chunk, decoded on first use if it was not preloaded.
+    // Returns nullptr (and remembers it) when the file cannot be decoded.
+    Mix_Chunk* get(const std::string& path);
+
+    // True once path has been decoded (or failed to decode)
+    bool has(const std::string& path) const { return chunks.count(path) != 0; }
+
+    // Takes ownership of a chunk decoded elsewhere (see AssetLoader).
+    // If path is already in the bank the new chunk is freed instead.
+    void adopt(const std::string& path, Mix_Chunk* chunk);
+
+    // Halts all channels and frees every chunk; call before Mix_CloseAudio()
+    // and before AssetPack::close(), since packed chunks borrow its memory
+    void clear();
+
+private:
+    SoundBank() = default;
+
+    std::map<std::string, Mix_Chunk*> chunks;
+};
+
+#endif // SOUND_BANK_H
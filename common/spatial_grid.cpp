@@ -0,0 +1,77 @@
+// common/spatial_grid.cpp
+#include "spatial_grid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(int cellSize) : cellSize(cellSize > 0 ? cellSize : DEFAULT_CELL_SIZE) {}
+
+// Floor division, so cells left of and above the origin are not folded into cell 0
+int SpatialGrid::cellOf(int coordinate) const {
+    return coordinate >= 0 ? coordinate / cellSize : -((-coordinate + cellSize - 1) / cellSize);
+}
+
+int SpatialGrid::insert(const SDL_Rect& rect, Uint32 kind, int value) {
+    int id = static_cast<int>(items.size());
+    items.push_back({rect, kind, value});
+    if (rect.w <= 0 || rect.h <= 0) return id;  // never overlaps anything
+
+    int x0 = cellOf(rect.x), x1 = cellOf(rect.x + rect.w - 1);
+    int y0 = cellOf(rect.y), y1 = cellOf(rect.y + rect.h - 1);
+    for (int cy = y0; cy <= y1; ++cy)
+        for (int cx = x0; cx <= x1; ++cx)
+            cells[key(cx, cy)].push_back(id);
+    return id;
+}
+
+void SpatialGrid::clear() {
+    items.clear();
+    // Empty the cells but keep them and their storage, so a grid refilled
+    // every step stops allocating once it has seen its busiest cells
+    for (auto& cell : cells) cell.second.clear();
+}
+
+template <typename Visit>
+bool SpatialGrid::forEachCandidate(const SDL_Rect& area, Uint32 mask, Visit visit) const {
+    if (area.w <= 0 || area.h <= 0) return false;
+
+    int x0 = cellOf(area.x), x1 = cellOf(area.x + area.w - 1);
+    int y0 = cellOf(area.y), y1 = cellOf(area.y + area.h - 1);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            auto cell = cells.find(key(cx, cy));
+            if (cell == cells.end()) continue;
+            for (int id : cell->second) {
+                const Item& item = items[id];
+                if ((item.kind & mask) && SDL_HasIntersection(&area, &item.rect) && visit(id)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SpatialGrid::overlapsAny(const SDL_Rect& area, Uint32 mask) const {
+    return forEachCandidate(area, mask, [](int) { return true; });
+}
+
+bool SpatialGrid::overlapsValue(const SDL_Rect& area, Uint32 mask, int value) const {
+    return forEachCandidate(area, mask, [this, value](int id) { return items[id].value == value; });
+}
+
+int SpatialGrid::first(const SDL_Rect& area, Uint32 mask) const {
+    int lowest = -1;
+    forEachCandidate(area, mask, [&lowest](int id) {
+        if (lowest < 0 || id < lowest) lowest = id;
+        return false;
+    });
+    return lowest;
+}
+
+void SpatialGrid::query(const SDL_Rect& area, std::vector<int>& out, Uint32 mask) const {
+    out.clear();
+    forEachCandidate(area, mask, [&out](int id) {
+        out.push_back(id);
+        return false;
+    });
+    // A rect spanning several cells is found once per cell
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
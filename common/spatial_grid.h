@@ -0,0 +1,77 @@
+// common/spatial_grid.h
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------
+// SpatialGrid indexes a floor's static rects (walls, doors, the zones a
+// player must stand in to use a door) in a uniform grid of square cells.
+// A rect is listed in every cell it touches, so a query only looks at the
+// rects sharing a cell with the area asked about; with hundreds of rects
+// on a floor a move still tests a handful.
+//
+// Each rect has a kind, a bit mask the caller defines (SOLID, DOOR, ...;
+// a rect may be several at once), and a value for the caller's own use,
+// such as the index of the door it belongs to. Queries take a mask and
+// only see rects sharing a bit with it. Cells live in a hash map, so the
+// grid needs no world size and negative coordinates work.
+//
+// It also serves as a broadphase for things that move: clear() and
+// insert() everything again each step. Cleared cells keep their storage.
+// ----------------------------------------------------
+class SpatialGrid {
+public:
+    static const int DEFAULT_CELL_SIZE = 128;
+    static const Uint32 ALL = 0xFFFFFFFFu;
+
+    explicit SpatialGrid(int cellSize = DEFAULT_CELL_SIZE);
+
+    // Adds rect and returns its id; ids count up from 0 in insertion order
+    int insert(const SDL_Rect& rect, Uint32 kind, int value = 0);
+    void clear();
+
+    size_t size() const { return items.size(); }
+    const SDL_Rect& rect(int id) const { return items[id].rect; }
+    Uint32 kind(int id) const { return items[id].kind; }
+    int value(int id) const { return items[id].value; }
+
+    // True if area overlaps any rect of a kind in mask
+    bool overlapsAny(const SDL_Rect& area, Uint32 mask = ALL) const;
+
+    // True if area overlaps a rect of a kind in mask whose value is value
+    // (is the player in the zone of door 2?)
+    bool overlapsValue(const SDL_Rect& area, Uint32 mask, int value) const;
+
+    // Lowest id overlapping area with a kind in mask, or -1
+    int first(const SDL_Rect& area, Uint32 mask = ALL) const;
+
+    // first() for the rects containing the point (x, y)
+    int firstAt(int x, int y, Uint32 mask = ALL) const { return first({x, y, 1, 1}, mask); }
+
+    // Every id overlapping area with a kind in mask, once each, ascending
+    void query(const SDL_Rect& area, std::vector<int>& out, Uint32 mask = ALL) const;
+
+private:
+    struct Item {
+        SDL_Rect rect;
+        Uint32 kind;
+        int value;
+    };
+
+    static uint64_t key(int cx, int cy) { return (uint64_t(uint32_t(cx)) << 32) | uint32_t(cy); }
+    int cellOf(int coordinate) const;
+
+    // Calls visit(id) for each candidate in the cells area covers, until it returns true
+    template <typename Visit>
+    bool forEachCandidate(const SDL_Rect& area, Uint32 mask, Visit visit) const;
+
+    int cellSize;
+    std::vector<Item> items;
+    std::unordered_map<uint64_t, std::vector<int>> cells;
+};
+
+#endif // SPATIAL_GRID_H
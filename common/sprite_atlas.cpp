@@ -0,0 +1,130 @@
+// common/sprite_atlas.cpp
+#include "sprite_atlas.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <iostream>
+#include "atlas_layout.h"
+
+// True if a source was modified after the atlas image was written. Files
+// that cannot be checked (shipped only in assets.pak) count as current.
+static bool isStale(const std::string& imagePath, const std::vector<std::string>& sources) {
+    struct stat info;
+    if (stat(imagePath.c_str(), &info) != 0) return false;
+    time_t built = info.st_mtime;
+    for (const std::string& source : sources)
+        if (stat(source.c_str(), &info) == 0 && info.st_mtime > built) return true;
+    return false;
+}
+
+// Region rects from a table on disk, in source order; false if the table
+// is missing or does not list every source
+static bool regionsFromTable(const std::string& tablePath, const std::vector<std::string>& sources,
+                             std::vector<SDL_Rect>& out) {
+    std::vector<AtlasRegion> table;
+    if (!readAtlasTable(tablePath, table)) return false;
+
+    out.clear();
+    for (const std::string& source : sources) {
+        bool found = false;
+        for (const AtlasRegion& region : table) {
+            if (region.name == source) {
+                out.push_back(region.rect);
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+    return true;
+}
+
+bool SpriteAtlas::load(SDL_Renderer* renderer, const std::string& base, const std::vector<std::string>& sources) {
+    const std::string imagePath = base + ".png";
+    TextureCache& textures = TextureCache::instance();
+
+    bool stale = isStale(imagePath, sources);
+    if (!stale && regionsFromTable(base + ".atlas", sources, regions))
+        texture = textures.acquire(renderer, imagePath);
+
+    if (!texture) {
+        std::cerr << "SpriteAtlas: " << (stale ? "out of date " : "no usable ") << base << ".png/.atlas; packing "
+                  << sources.size() << " sprites at runtime" << std::endl;
+        // A preload may have made the old image resident under the same name
+        if (stale) textures.evict(renderer, imagePath);
+        std::vector<AtlasRegion> packed;
+        SDL_Surface* surface = buildAtlasSurface(sources, packed);
+        if (!surface) return false;
+
+        // Cached under the file's name, so the next load finds it resident
+        textures.adopt(renderer, imagePath, surface);
+        SDL_FreeSurface(surface);
+        texture = textures.acquire(renderer, imagePath);
+        regions.clear();
+        for (const AtlasRegion& region : packed) regions.push_back(region.rect);
+    }
+
+    if (!texture) return false;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    return true;
+}
+
+bool SpriteAtlas::fromSurfaces(SDL_Renderer* renderer, const std::string& name,
+                               const std::vector<SDL_Surface*>& sprites) {
+    TextureCache& textures = TextureCache::instance();
+    regions.clear();
+    texture.reset();
+
+    bool complete = std::find(sprites.begin(), sprites.end(), nullptr) == sprites.end();
+    std::vector<AtlasRegion> packed;
+    SDL_Surface* surface = nullptr;
+    if (complete) {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < sprites.size(); ++i) names.push_back(name + "#" + std::to_string(i));
+        surface = packAtlasSurface(sprites, names, packed);
+    } else {
+        for (SDL_Surface* sprite : sprites)
+            if (sprite) SDL_FreeSurface(sprite);
+    }
+    if (!surface) {
+        std::cerr << "SpriteAtlas: cannot build " << name << std::endl;
+        return false;
+    }
+
+    textures.adopt(renderer, name, surface);
+    SDL_FreeSurface(surface);
+    texture = textures.acquire(renderer, name);
+    for (const AtlasRegion& region : packed) regions.push_back(region.rect);
+
+    if (!texture) return false;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    return true;
+}
+
+void SpriteAtlas::draw(SDL_Renderer* renderer, int region, const SDL_Rect& dst) const {
+    SDL_RenderCopy(renderer, texture, &regions[region], &dst);
+}
+
+void SpriteAtlas::queue(int region, const SDL_Rect& dst) {
+    const SDL_Rect& src = regions[region];
+    const float u0 = float(src.x) / width, v0 = float(src.y) / height;
+    const float u1 = float(src.x + src.w) / width, v1 = float(src.y + src.h) / height;
+    const SDL_Color white = {255, 255, 255, 255};
+
+    int first = static_cast<int>(vertices.size());
+    vertices.push_back({{float(dst.x), float(dst.y)}, white, {u0, v0}});
+    vertices.push_back({{float(dst.x + dst.w), float(dst.y)}, white, {u1, v0}});
+    vertices.push_back({{float(dst.x + dst.w), float(dst.y + dst.h)}, white, {u1, v1}});
+    vertices.push_back({{float(dst.x), float(dst.y + dst.h)}, white, {u0, v1}});
+    indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+}
+
+void SpriteAtlas::flush(SDL_Renderer* renderer, SDL_Color tint) {
+    if (indices.empty()) return;
+    SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+    if (SDL_RenderGeometry(renderer, texture, vertices.data(), int(vertices.size()),
+                           indices.data(), int(indices.size())) < 0) {
+        std::cerr << "SpriteAtlas: SDL_RenderGeometry failed: " << SDL_GetError() << std::endl;
+    }
+    vertices.clear();
+    indices.clear();
+}
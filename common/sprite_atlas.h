@@ -0,0 +1,50 @@
+// common/sprite_atlas.h
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "texture_cache.h"
+
+// ----------------------------------------------------
+// SpriteAtlas draws a minigame's sprites out of one texture. It loads
+// <base>.png and <base>.atlas written by `make atlases`; if they are
+// missing or out of date (a source modified after <base>.png) it packs
+// the sources itself at load time (same layout code, so the result is
+// the same, only slower to start).
+//
+// Region ids are indices into the source list given to load(), so a
+// scene can name them with an enum in the same order. queue() + flush()
+// draw every queued sprite with one SDL_RenderGeometry call.
+// ----------------------------------------------------
+class SpriteAtlas {
+public:
+    bool load(SDL_Renderer* renderer, const std::string& base, const std::vector<std::string>& sources);
+
+    // Packs sprites made at runtime (rendered text, ...) instead of files,
+    // caching the texture under name; the same name must mean the same
+    // sprites. Frees every sprite; false if any is nullptr.
+    bool fromSurfaces(SDL_Renderer* renderer, const std::string& name, const std::vector<SDL_Surface*>& sprites);
+    bool isLoaded() const { return texture.get() != nullptr; }
+
+    const SDL_Rect& rect(int region) const { return regions[region]; }
+
+    // Immediate draw, like SDL_RenderCopy
+    void draw(SDL_Renderer* renderer, int region, const SDL_Rect& dst) const;
+
+    // Deferred draw; nothing appears until flush(), which tints the whole
+    // batch with SDL_SetTextureColorMod
+    void queue(int region, const SDL_Rect& dst);
+    void flush(SDL_Renderer* renderer, SDL_Color tint = {255, 255, 255, 255});
+
+private:
+    TextureHandle texture;
+    std::vector<SDL_Rect> regions;
+    int width = 0, height = 0;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+#endif // SPRITE_ATLAS_H
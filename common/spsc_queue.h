@@ -0,0 +1,53 @@
+// common/spsc_queue.h
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// ----------------------------------------------------
+// SpscQueue is a fixed-size ring for exactly one producer thread and one
+// consumer thread. Neither side takes a lock: each owns one index and
+// publishes it with a release store, so a push or pop is a couple of
+// atomic loads and a move. Capacity must be a power of two; one slot is
+// kept empty to tell full from empty.
+// ----------------------------------------------------
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer only; false if the ring is full, in which case item is untouched
+    bool tryPush(T&& item) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) & (Capacity - 1);
+        if (next == headIndex.load(std::memory_order_acquire)) return false;
+        slots[tail] = std::move(item);
+        tailIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only; false if the ring is empty
+    bool tryPop(T& item) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) return false;
+        item = std::move(slots[head]);
+        slots[head] = T();
+        headIndex.store((head + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+    // Either side; only a hint while the other side is running
+    bool empty() const {
+        return headIndex.load(std::memory_order_acquire) == tailIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    // Separate cache lines so the two threads do not fight over one
+    alignas(64) std::atomic<size_t> headIndex{0};
+    alignas(64) std::atomic<size_t> tailIndex{0};
+    T slots[Capacity];
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,267 @@
+// common/text_renderer.cpp
+#include "text_renderer.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const int PAGE_SIZE = 512;
+const int GLYPH_PADDING = 1;
+
+struct Glyph {
+    int page = -1;          // -1: nothing to draw (space, missing glyph)
+    SDL_Rect src = {0, 0, 0, 0};
+    int offsetX = 0;        // where the bitmap starts relative to the pen
+    int advance = 0;
+};
+
+// One atlas per renderer and font face/size. Glyphs are packed in shelves
+// onto fixed-size pages; a new page is started when the current one fills.
+struct Atlas {
+    SDL_Renderer* renderer = nullptr;
+    std::string family;
+    std::string styleName;
+    int height = 0;
+    int ascent = 0;
+    int style = 0;
+
+    int lineSkip = 0;
+    std::vector<SDL_Texture*> pages;
+    int penX = 0, penY = 0, shelfHeight = 0;
+    std::unordered_map<Uint32, Glyph> glyphs;
+};
+
+struct Quad {
+    int page;
+    SDL_Rect src;
+    int x, y;
+};
+
+std::vector<std::unique_ptr<Atlas>> atlases;
+
+// Scratch buffers reused between calls so drawing text does not allocate
+std::vector<Uint32> codepoints;
+std::vector<Quad> quads;
+std::vector<SDL_Vertex> vertices;
+std::vector<int> indices;
+
+bool matches(const Atlas& atlas, SDL_Renderer* renderer, TTF_Font* font) {
+    const char* family = TTF_FontFaceFamilyName(font);
+    const char* styleName = TTF_FontFaceStyleName(font);
+    return atlas.renderer == renderer &&
+           atlas.height == TTF_FontHeight(font) &&
+           atlas.ascent == TTF_FontAscent(font) &&
+           atlas.style == TTF_GetFontStyle(font) &&
+           atlas.family == (family ? family : "") &&
+           atlas.styleName == (styleName ? styleName : "");
+}
+
+Atlas& atlasFor(SDL_Renderer* renderer, TTF_Font* font) {
+    for (auto& atlas : atlases)
+        if (matches(*atlas, renderer, font)) return *atlas;
+
+    auto atlas = std::make_unique<Atlas>();
+    const char* family = TTF_FontFaceFamilyName(font);
+    const char* styleName = TTF_FontFaceStyleName(font);
+    atlas->renderer = renderer;
+    atlas->family = family ? family : "";
+    atlas->styleName = styleName ? styleName : "";
+    atlas->height = TTF_FontHeight(font);
+    atlas->ascent = TTF_FontAscent(font);
+    atlas->style = TTF_GetFontStyle(font);
+    atlas->lineSkip = TTF_FontLineSkip(font);
+    atlases.push_back(std::move(atlas));
+    return *atlases.back();
+}
+
+bool addPage(Atlas& atlas) {
+    SDL_Texture* page = SDL_CreateTexture(atlas.renderer, SDL_PIXELFORMAT_ARGB8888,
+                                          SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+    if (!page) {
+        std::cerr << "Glyph atlas page creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    std::vector<Uint32> blank(PAGE_SIZE * PAGE_SIZE, 0);
+    SDL_UpdateTexture(page, nullptr, blank.data(), PAGE_SIZE * 4);
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+    atlas.pages.push_back(page);
+    atlas.penX = atlas.penY = atlas.shelfHeight = 0;
+    return true;
+}
+
+// Find room for a w x h bitmap on the current page, starting a new shelf
+// or page as needed. Returns false if the glyph cannot be placed at all.
+bool reserve(Atlas& atlas, int w, int h, SDL_Rect& out) {
+    if (w + GLYPH_PADDING > PAGE_SIZE || h + GLYPH_PADDING > PAGE_SIZE) return false;
+    if (atlas.pages.empty() && !addPage(atlas)) return false;
+
+    if (atlas.penX + w + GLYPH_PADDING > PAGE_SIZE) {
+        atlas.penX = 0;
+        atlas.penY += atlas.shelfHeight;
+        atlas.shelfHeight = 0;
+    }
+    if (atlas.penY + h + GLYPH_PADDING > PAGE_SIZE && !addPage(atlas)) return false;
+
+    out = {atlas.penX, atlas.penY, w, h};
+    atlas.penX += w + GLYPH_PADDING;
+    atlas.shelfHeight = std::max(atlas.shelfHeight, h + GLYPH_PADDING);
+    return true;
+}
+
+const Glyph& glyphFor(Atlas& atlas, TTF_Font* font, Uint32 codepoint) {
+    auto it = atlas.glyphs.find(codepoint);
+    if (it != atlas.glyphs.end()) return it->second;
+
+    Glyph glyph;
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+    if (TTF_GlyphMetrics32(font, codepoint, &minx, &maxx, &miny, &maxy, &advance) == 0) {
+        glyph.advance = advance;
+        // SDL_ttf shifts the bitmap right when the glyph overhangs the pen
+        glyph.offsetX = std::min(0, minx);
+
+        SDL_Surface* rendered = maxx > minx
+            ? TTF_RenderGlyph32_Blended(font, codepoint, {255, 255, 255, 255})
+            : nullptr;
+        SDL_Surface* surface = rendered;
+        if (rendered && rendered->format->format != SDL_PIXELFORMAT_ARGB8888)
+            surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+
+        SDL_Rect slot;
+        if (surface && reserve(atlas, surface->w, surface->h, slot)) {
+            SDL_UpdateTexture(atlas.pages.back(), &slot, surface->pixels, surface->pitch);
+            glyph.page = static_cast<int>(atlas.pages.size()) - 1;
+            glyph.src = slot;
+        }
+
+        if (surface && surface != rendered) SDL_FreeSurface(surface);
+        if (rendered) SDL_FreeSurface(rendered);
+    }
+    return atlas.glyphs.emplace(codepoint, glyph).first->second;
+}
+
+// Decode the next UTF-8 code point; malformed bytes come back as '?'
+Uint32 nextCodepoint(const std::string& text, size_t& i) {
+    unsigned char c = static_cast<unsigned char>(text[i++]);
+    if (c < 0x80) return c;
+
+    int extra = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : -1;
+    if (extra < 0 || i + extra > text.size()) return '?';
+    Uint32 cp = c & (0x3F >> extra);
+    for (int k = 0; k < extra; ++k) {
+        unsigned char cont = static_cast<unsigned char>(text[i]);
+        if ((cont & 0xC0) != 0x80) return '?';
+        cp = (cp << 6) | (cont & 0x3F);
+        ++i;
+    }
+    return cp;
+}
+
+// Lay text out into `quads` relative to (0, 0) and return its bounds.
+SDL_Rect layout(Atlas& atlas, TTF_Font* font, const std::string& text, int wrapLength) {
+    quads.clear();
+    if (text.empty()) return {0, 0, 0, 0};
+
+    codepoints.clear();
+    for (size_t i = 0; i < text.size();) codepoints.push_back(nextCodepoint(text, i));
+
+    int maxWidth = 0, lineCount = 1;
+    int penX = 0, lineY = 0;
+    Uint32 previous = 0;
+
+    auto newLine = [&]() {
+        maxWidth = std::max(maxWidth, penX);
+        penX = 0;
+        lineY += atlas.lineSkip;
+        previous = 0;
+        ++lineCount;
+    };
+
+    for (size_t i = 0; i < codepoints.size(); ++i) {
+        Uint32 cp = codepoints[i];
+        if (cp == '\n') {
+            newLine();
+            continue;
+        }
+
+        if (wrapLength > 0 && cp == ' ' && penX > 0) {
+            // Measure the next word and break here if it would overflow
+            int wordWidth = glyphFor(atlas, font, ' ').advance;
+            for (size_t j = i + 1; j < codepoints.size() && codepoints[j] != ' ' && codepoints[j] != '\n'; ++j)
+                wordWidth += glyphFor(atlas, font, codepoints[j]).advance;
+            if (penX + wordWidth > wrapLength) {
+                newLine();
+                continue;
+            }
+        }
+
+        if (previous) penX += TTF_GetFontKerningSizeGlyphs32(font, previous, cp);
+        const Glyph& glyph = glyphFor(atlas, font, cp);
+        if (glyph.page >= 0)
+            quads.push_back({glyph.page, glyph.src, penX + glyph.offsetX, lineY});
+        penX += glyph.advance;
+        previous = cp;
+    }
+
+    maxWidth = std::max(maxWidth, penX);
+    int height = atlas.height + (lineCount - 1) * atlas.lineSkip;
+    return {0, 0, maxWidth, height};
+}
+
+} // namespace
+
+SDL_Rect drawText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                  SDL_Color color, int x, int y, int wrapLength) {
+    if (!renderer || !font || text.empty()) return {x, y, 0, 0};
+
+    Atlas& atlas = atlasFor(renderer, font);
+    SDL_Rect bounds = layout(atlas, font, text, wrapLength);
+    bounds.x = x;
+    bounds.y = y;
+
+    // One geometry batch per atlas page touched (almost always just one)
+    for (int page = 0; page < static_cast<int>(atlas.pages.size()); ++page) {
+        vertices.clear();
+        indices.clear();
+        const float invSize = 1.0f / PAGE_SIZE;
+        for (const Quad& q : quads) {
+            if (q.page != page) continue;
+            float x0 = float(x + q.x), y0 = float(y + q.y);
+            float x1 = x0 + q.src.w, y1 = y0 + q.src.h;
+            float u0 = q.src.x * invSize, v0 = q.src.y * invSize;
+            float u1 = (q.src.x + q.src.w) * invSize, v1 = (q.src.y + q.src.h) * invSize;
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back({{x0, y0}, color, {u0, v0}});
+            vertices.push_back({{x1, y0}, color, {u1, v0}});
+            vertices.push_back({{x1, y1}, color, {u1, v1}});
+            vertices.push_back({{x0, y1}, color, {u0, v1}});
+            int quadIndices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            indices.insert(indices.end(), quadIndices, quadIndices + 6);
+        }
+        if (!vertices.empty()) {
+            SDL_RenderGeometry(renderer, atlas.pages[page], vertices.data(),
+                               static_cast<int>(vertices.size()), indices.data(),
+                               static_cast<int>(indices.size()));
+        }
+    }
+    return bounds;
+}
+
+SDL_Rect measureText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                     int wrapLength) {
+    if (!renderer || !font || text.empty()) return {0, 0, 0, 0};
+    return layout(atlasFor(renderer, font), font, text, wrapLength);
+}
+
+void clearTextCache(SDL_Renderer* renderer) {
+    for (auto it = atlases.begin(); it != atlases.end();) {
+        if (renderer && (*it)->renderer != renderer) {
+            ++it;
+            continue;
+        }
+        for (SDL_Texture* page : (*it)->pages) SDL_DestroyTexture(page);
+        it = atlases.erase(it);
+    }
+}
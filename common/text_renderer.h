@@ -0,0 +1,30 @@
+// common/text_renderer.h
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+
+// ----------------------------------------------------
+// Glyph-atlas text rendering.
+// Every (font face, size) gets a packed atlas texture holding each glyph
+// it has drawn so far. A string is laid out from cached glyph metrics and
+// submitted as one SDL_RenderGeometry call, so drawing HUD and menu text
+// every frame no longer rasterizes or creates textures.
+// ----------------------------------------------------
+
+// Draw text with its top-left corner at (x, y) and return the area it covers.
+// Lines break on '\n' and, when wrapLength > 0, at spaces past that width.
+SDL_Rect drawText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                  SDL_Color color, int x, int y, int wrapLength = 0);
+
+// Size drawText would cover, without drawing (x and y are 0)
+SDL_Rect measureText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                     int wrapLength = 0);
+
+// Free the atlases built for renderer (all renderers if nullptr).
+// Must run before that renderer is destroyed.
+void clearTextCache(SDL_Renderer* renderer = nullptr);
+
+#endif // TEXT_RENDERER_H
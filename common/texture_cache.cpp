@@ -0,0 +1,116 @@
+// common/texture_cache.cpp
+#include "texture_cache.h"
+#include "utils.h"
+#include "asset_pack.h"
+#include <iostream>
+
+TextureCache& TextureCache::instance() {
+    // Never destroyed: floors keep handles in static storage, and those may
+    // be torn down after any function-local static would be.
+    static TextureCache* cache = new TextureCache();
+    return *cache;
+}
+
+// Pre-decoded pixels from assets.pak when packed, otherwise the PNG on disk
+static SDL_Texture* createTexture(SDL_Renderer* renderer, const std::string& path) {
+    if (SDL_Texture* packed = AssetPack::instance().createTexture(renderer, path)) return packed;
+    return loadTexture(renderer, path);
+}
+
+TextureHandle TextureCache::acquire(SDL_Renderer* renderer, const std::string& path) {
+    auto it = entries.find({renderer, path});
+    if (it == entries.end()) {
+        SDL_Texture* texture = createTexture(renderer, path);
+        if (!texture) {
+            std::cerr << "TextureCache: failed to load " << path << std::endl;
+            return TextureHandle();
+        }
+        it = entries.emplace(Key{renderer, path}, Entry{texture, 0}).first;
+    } else if (!it->second.texture) {
+        // Entry survived a clear() because handles were still alive
+        it->second.texture = createTexture(renderer, path);
+        if (!it->second.texture) return TextureHandle();
+    }
+    return TextureHandle(&it->second);
+}
+
+bool TextureCache::isLoaded(SDL_Renderer* renderer, const std::string& path) const {
+    auto it = entries.find({renderer, path});
+    return it != entries.end() && it->second.texture;
+}
+
+void TextureCache::adopt(SDL_Renderer* renderer, const std::string& path, SDL_Surface* surface) {
+    Entry& entry = entries[{renderer, path}];
+    if (entry.texture) return;
+
+    entry.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!entry.texture) {
+        std::cerr << "TextureCache: failed to upload " << path << ": " << SDL_GetError() << std::endl;
+        if (entry.refs == 0) entries.erase({renderer, path});
+    }
+}
+
+void TextureCache::purgeUnused() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.refs == 0) {
+            if (it->second.texture) SDL_DestroyTexture(it->second.texture);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextureCache::evict(SDL_Renderer* renderer, const std::string& path) {
+    auto it = entries.find({renderer, path});
+    if (it == entries.end() || it->second.refs > 0) return;
+    if (it->second.texture) SDL_DestroyTexture(it->second.texture);
+    entries.erase(it);
+}
+
+void TextureCache::clear(SDL_Renderer* renderer) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (renderer && it->first.first != renderer) {
+            ++it;
+            continue;
+        }
+        if (it->second.texture) {
+            SDL_DestroyTexture(it->second.texture);
+            it->second.texture = nullptr;
+        }
+        if (it->second.refs == 0) it = entries.erase(it);
+        else ++it;
+    }
+}
+
+void TextureCache::retain(Entry* entry) {
+    ++entry->refs;
+}
+
+void TextureCache::release(Entry* entry) {
+    --entry->refs;
+}
+
+TextureHandle::TextureHandle(TextureCache::Entry* entry) : entry(entry) {
+    if (entry) TextureCache::instance().retain(entry);
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other) : TextureHandle(other.entry) {}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept : entry(other.entry) {
+    other.entry = nullptr;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle other) noexcept {
+    std::swap(entry, other.entry);
+    return *this;
+}
+
+TextureHandle::~TextureHandle() {
+    reset();
+}
+
+void TextureHandle::reset() {
+    if (entry) TextureCache::instance().release(entry);
+    entry = nullptr;
+}
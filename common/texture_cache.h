@@ -0,0 +1,87 @@
+// common/texture_cache.h
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <map>
+#include <string>
+#include <utility>
+
+class TextureHandle;
+
+// ----------------------------------------------------
+// TextureCache keeps a single decoded copy of every image, keyed by path.
+// Floors and minigames acquire ref-counted handles instead of calling
+// IMG_LoadTexture themselves. A texture stays resident after its last
+// handle is dropped, so walking back into a floor or minigame does not
+// decode the PNG again.
+// ----------------------------------------------------
+class TextureCache {
+public:
+    static TextureCache& instance();
+
+    // Returns a handle to the texture for path, decoding it on first use.
+    // The handle is empty (converts to nullptr) if the image failed to load.
+    TextureHandle acquire(SDL_Renderer* renderer, const std::string& path);
+
+    bool isLoaded(SDL_Renderer* renderer, const std::string& path) const;
+
+    // Uploads a surface decoded elsewhere (see AssetLoader) under path.
+    // The caller keeps ownership of surface. No-op if path is already resident.
+    void adopt(SDL_Renderer* renderer, const std::string& path, SDL_Surface* surface);
+
+    // Frees textures that no handle refers to any more
+    void purgeUnused();
+
+    // Frees path's texture if no handle refers to it; for streamed
+    // textures (TiledBackground) that must not pile up in the cache
+    void evict(SDL_Renderer* renderer, const std::string& path);
+
+    // Frees every texture created for renderer (all renderers if nullptr).
+    // Must run before that renderer is destroyed; handles still alive
+    // afterwards resolve to nullptr.
+    void clear(SDL_Renderer* renderer = nullptr);
+
+private:
+    struct Entry {
+        SDL_Texture* texture = nullptr;
+        int refs = 0;
+    };
+    using Key = std::pair<SDL_Renderer*, std::string>;
+
+    TextureCache() = default;
+    void retain(Entry* entry);
+    void release(Entry* entry);
+
+    std::map<Key, Entry> entries;
+
+    friend class TextureHandle;
+};
+
+// ----------------------------------------------------
+// TextureHandle is a counted reference to a cached texture.
+// It converts to SDL_Texture* so it drops into SDL_RenderCopy calls.
+// ----------------------------------------------------
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(TextureHandle other) noexcept;
+    ~TextureHandle();
+
+    SDL_Texture* get() const { return entry ? entry->texture : nullptr; }
+    operator SDL_Texture*() const { return get(); }
+
+    // Drops this reference; the texture itself stays in the cache
+    void reset();
+
+private:
+    explicit TextureHandle(TextureCache::Entry* entry);
+
+    TextureCache::Entry* entry = nullptr;
+
+    friend class TextureCache;
+};
+
+#endif // TEXTURE_CACHE_H
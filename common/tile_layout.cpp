@@ -0,0 +1,31 @@
+// common/tile_layout.cpp
+#include "tile_layout.h"
+#include <fstream>
+#include <sstream>
+
+std::string tileManifestPath(const std::string& dir) {
+    return dir + "/tiles.txt";
+}
+
+std::string tilePath(const std::string& dir, int row, int col) {
+    return dir + "/" + std::to_string(row) + "_" + std::to_string(col) + ".png";
+}
+
+bool writeTileManifest(const std::string& dir, const TileManifest& manifest) {
+    std::ofstream out(tileManifestPath(dir));
+    if (!out) return false;
+    out << "tiles " << manifest.width << " " << manifest.height << " " << manifest.tileSize << "\n";
+    return bool(out);
+}
+
+bool readTileManifest(const std::string& dir, TileManifest& manifest) {
+    std::ifstream in(tileManifestPath(dir));
+    std::string line, tag;
+    TileManifest read;
+    if (!std::getline(in, line) ||
+        !(std::istringstream(line) >> tag >> read.width >> read.height >> read.tileSize) || tag != "tiles")
+        return false;
+    if (read.width <= 0 || read.height <= 0 || read.tileSize <= 0) return false;
+    manifest = read;
+    return true;
+}
@@ -0,0 +1,30 @@
+// common/tile_layout.h
+#ifndef TILE_LAYOUT_H
+#define TILE_LAYOUT_H
+
+#include <string>
+
+// ----------------------------------------------------
+// Shared by tools/tile_cutter and TiledBackground. A floor background is
+// cut into square tiles, each its own PNG in one directory:
+//     <dir>/tiles.txt        tiles <world width> <world height> <tile size>
+//     <dir>/<row>_<col>.png  tile size square, smaller along the right
+//                            and bottom edges
+// ----------------------------------------------------
+static const int TILE_SIZE = 512;
+
+struct TileManifest {
+    int width = 0, height = 0;
+    int tileSize = TILE_SIZE;
+
+    int cols() const { return (width + tileSize - 1) / tileSize; }
+    int rows() const { return (height + tileSize - 1) / tileSize; }
+};
+
+std::string tileManifestPath(const std::string& dir);
+std::string tilePath(const std::string& dir, int row, int col);
+
+bool writeTileManifest(const std::string& dir, const TileManifest& manifest);
+bool readTileManifest(const std::string& dir, TileManifest& manifest);
+
+#endif // TILE_LAYOUT_H
@@ -0,0 +1,127 @@
+// common/tiled_background.cpp
+#include "tiled_background.h"
+#include "asset_loader.h"
+#include <algorithm>
+#include <iostream>
+
+bool TiledBackground::open(SDL_Renderer* renderer, const std::string& tileDir, const std::string& image) {
+    close();
+    this->renderer = renderer;
+    dir = tileDir;
+
+    if (!readTileManifest(dir, manifest)) {
+        // No tiles built: the whole image is the one tile
+        TextureHandle whole = TextureCache::instance().acquire(renderer, image);
+        if (!whole) return false;
+        this->image = image;
+        manifest = TileManifest();
+        SDL_QueryTexture(whole, nullptr, nullptr, &manifest.width, &manifest.height);
+        manifest.tileSize = std::max(manifest.width, manifest.height);
+        tiles.assign(1, whole);
+        return true;
+    }
+
+    tiles.assign(manifest.rows() * manifest.cols(), TextureHandle());
+    return true;
+}
+
+void TiledBackground::appendTiles(AssetList& list, const std::string& tileDir, const std::string& image) {
+    TileManifest manifest;
+    if (!readTileManifest(tileDir, manifest)) {
+        list.images.push_back(image);
+        return;
+    }
+    for (int row = 0; row < manifest.rows(); ++row)
+        for (int col = 0; col < manifest.cols(); ++col)
+            list.images.push_back(tilePath(tileDir, row, col));
+}
+
+void TiledBackground::close() {
+    if (!renderer) return;
+    for (int row = 0; row < manifest.rows(); ++row) {
+        for (int col = 0; col < manifest.cols(); ++col) {
+            tile(row, col).reset();
+            // The single fallback image stays cached like any other texture
+            if (image.empty()) release(row, col);
+        }
+    }
+    tiles.clear();
+    manifest = TileManifest();
+    image.clear();
+    streaming = false;
+    renderer = nullptr;
+}
+
+std::string TiledBackground::path(int row, int col) const {
+    return image.empty() ? tilePath(dir, row, col) : image;
+}
+
+TiledBackground::Span TiledBackground::tilesAround(const SDL_Rect& camera, int margin) const {
+    int size = manifest.tileSize;
+    Span span;
+    span.col0 = std::max(0, camera.x / size - margin);
+    span.row0 = std::max(0, camera.y / size - margin);
+    span.col1 = std::min(manifest.cols() - 1, (camera.x + camera.w - 1) / size + margin);
+    span.row1 = std::min(manifest.rows() - 1, (camera.y + camera.h - 1) / size + margin);
+    return span;
+}
+
+void TiledBackground::stream(const SDL_Rect& camera) {
+    if (!renderer || !image.empty()) return;
+    TextureCache& cache = TextureCache::instance();
+    AssetLoader& loader = AssetLoader::instance();
+
+    // Ask for everything near the camera that is not here yet
+    Span near = tilesAround(camera, PREFETCH_TILES);
+    AssetList wanted;
+    for (int row = near.row0; row <= near.row1; ++row)
+        for (int col = near.col0; col <= near.col1; ++col)
+            if (!tile(row, col)) wanted.images.push_back(path(row, col));
+    if (!wanted.images.empty()) loader.queue(renderer, wanted);
+    loader.pump();
+
+    // Pin what has landed; drop what is well behind the camera
+    Span keep = tilesAround(camera, KEEP_TILES);
+    streaming = false;
+    for (int row = 0; row < manifest.rows(); ++row) {
+        for (int col = 0; col < manifest.cols(); ++col) {
+            TextureHandle& handle = tile(row, col);
+            bool isNear = row >= near.row0 && row <= near.row1 && col >= near.col0 && col <= near.col1;
+            bool isKept = row >= keep.row0 && row <= keep.row1 && col >= keep.col0 && col <= keep.col1;
+            if (!handle && isNear) {
+                std::string tilePath = path(row, col);
+                if (cache.isLoaded(renderer, tilePath)) handle = cache.acquire(renderer, tilePath);
+                else streaming = true;
+            } else if (!isKept) {
+                // Also catches tiles preloaded or landed after leaving range
+                handle.reset();
+                release(row, col);
+            }
+        }
+    }
+}
+
+void TiledBackground::release(int row, int col) {
+    std::string file = path(row, col);
+    AssetLoader::instance().cancel(file);
+    TextureCache::instance().evict(renderer, file);
+}
+
+void TiledBackground::draw(SDL_Renderer* renderer, const SDL_Rect& camera) {
+    if (tiles.empty()) return;
+
+    Span visible = tilesAround(camera, 0);
+    int size = manifest.tileSize;
+    for (int row = visible.row0; row <= visible.row1; ++row) {
+        for (int col = visible.col0; col <= visible.col1; ++col) {
+            TextureHandle& handle = tile(row, col);
+            if (!handle) handle = TextureCache::instance().acquire(renderer, path(row, col));
+            if (!handle) continue;
+
+            SDL_Rect world = {col * size, row * size, 0, 0};
+            SDL_QueryTexture(handle, nullptr, nullptr, &world.w, &world.h);
+            SDL_Rect dst = {world.x - camera.x, world.y - camera.y, world.w, world.h};
+            SDL_RenderCopy(renderer, handle, nullptr, &dst);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// common/tiled_background.h
+#ifndef TILED_BACKGROUND_H
+#define TILED_BACKGROUND_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "asset_loader.h"
+#include "texture_cache.h"
+#include "tile_layout.h"
+
+// ----------------------------------------------------
+// TiledBackground draws a floor's background from the tiles `make tiles`
+// cut it into (see tile_layout.h), so a floor can be far larger than the
+// biggest texture the GPU accepts.
+//
+// Each frame, stream() queues the tiles around the camera on AssetLoader,
+// uploads whatever has been decoded and lets go of tiles that are well
+// out of view, so only a few screens' worth stays on the GPU; a tile still
+// loading when it leaves is dropped as it lands. draw() copies just the
+// tiles the camera overlaps. Floors preload their tiles with appendTiles()
+// so the first frame has them; a visible tile missing later on is loaded
+// on the spot rather than left as a hole.
+//
+// Without a tile directory it falls back to the whole image as one tile.
+// ----------------------------------------------------
+class TiledBackground {
+public:
+    // Tiles decoded ahead of the camera, and kept after it leaves, in tiles
+    static const int PREFETCH_TILES = 1;
+    static const int KEEP_TILES = 2;
+
+    ~TiledBackground() { close(); }
+
+    // Adds what open(tileDir, image) would draw to a floor's preload list
+    static void appendTiles(AssetList& list, const std::string& tileDir, const std::string& image);
+
+    // Opens tileDir, or image as a single tile if tileDir has no manifest
+    bool open(SDL_Renderer* renderer, const std::string& tileDir, const std::string& image);
+    void close();
+
+    // World size in pixels
+    int width() const { return manifest.width; }
+    int height() const { return manifest.height; }
+
+    void stream(const SDL_Rect& camera);
+
+    // True while tiles near the camera are still on their way
+    bool isStreaming() const { return streaming; }
+
+    // Draws the part of the world under camera at the window's top left
+    void draw(SDL_Renderer* renderer, const SDL_Rect& camera);
+
+private:
+    struct Span {
+        int row0, row1, col0, col1;  // inclusive; empty if row0 > row1
+    };
+
+    Span tilesAround(const SDL_Rect& camera, int margin) const;
+    std::string path(int row, int col) const;
+    void release(int row, int col);  // evicts the tile, or cancels it in flight
+    TextureHandle& tile(int row, int col) { return tiles[row * manifest.cols() + col]; }
+
+    SDL_Renderer* renderer = nullptr;
+    std::string dir;
+    std::string image;  // set when there are no tiles
+    TileManifest manifest;
+    std::vector<TextureHandle> tiles;  // row major; empty handle = not resident
+    bool streaming = false;
+};
+
+#endif // TILED_BACKGROUND_H
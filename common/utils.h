@@ -8,7 +8,8 @@
 // Load image file and return texture
 SDL_Texture* loadTexture(SDL_Renderer* renderer, const std::string& path);
 
-// Render text and return texture (fills rectOut with size)
+// Render text and return texture (fills rectOut with size).
+// Rasterizes on every call; text drawn each frame should use drawText().
 SDL_Texture* renderText(SDL_Renderer* renderer, TTF_Font* font,
                         const std::string& text, SDL_Color color,
                         SDL_Rect& rectOut, int wrapLength = 800);
@@ -11,9 +11,15 @@
 #include "puzzle_game.h"
 #include "rsa_game.h"
 #include "../../common/utils.h"
-
-bool runPuzzleGame(SDL_Renderer* renderer);
-void runRSAGame(SDL_Renderer* renderer);
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/asset_loader.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/spatial_grid.h"
+#include "../../common/tiled_background.h"
+#include "../../UI/message_scene.h"
 
 static const int SCREEN_WIDTH = 800;
 static const int SCREEN_HEIGHT = 600;
@@ -21,35 +27,62 @@ static int WORLD_WIDTH = 1600;
 static int WORLD_HEIGHT = 1200;
 static bool puzzleSolved = false;
 
-static SDL_Texture* backgroundTexture = nullptr;
-static SDL_Texture* playerTexture = nullptr;
+// Background tiles, or the whole image if `make tiles` has not run
+static const char* BACKGROUND_TILES = "assets/tiles/floor1";
+static const char* BACKGROUND_IMAGE = "assets/images/floor1.png";
+static TiledBackground background;
+static TextureHandle playerTexture;
 static Mix_Chunk* moveSfx = nullptr; // Robot move sound
 
 static SDL_Rect camera = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
 
-static SDL_Rect obstacles[]  = {{300, 280, 450, 400}};
-static SDL_Rect obstacles1[] = {{200, 80, 100, 80}};
-static SDL_Rect obstacles2[] = {{450, 80, 100, 80}};
-static SDL_Rect obstacles3[] = {{720, 80, 100, 80}};
-
-static int redCount = sizeof(obstacles) / sizeof(obstacles[0]);
-static int count1   = sizeof(obstacles1) / sizeof(obstacles1[0]);
-static int count2   = sizeof(obstacles2) / sizeof(obstacles2[0]);
-static int count3   = sizeof(obstacles3) / sizeof(obstacles3[0]);
+// Kinds of rect in the floor's SpatialGrid
+enum : Uint32 { SOLID = 1, DOOR = 2, REACH = 4 };
+
+// A door blocks movement and can be used while player.x is strictly
+// between reachMinX and reachMaxX
+struct Door {
+    SDL_Rect rect;
+    int reachMinX, reachMaxX;
+};
+
+enum { PUZZLE_DOOR, RSA_DOOR, EXIT_DOOR };
+
+static const SDL_Rect walls[] = {{300, 280, 450, 400}};
+static const Door doors[] = {
+    {{200, 80, 100, 80}, 210, 296},  // PUZZLE_DOOR
+    {{450, 80, 100, 80}, 445, 535},  // RSA_DOOR
+    {{720, 80, 100, 80}, 706, 793},  // EXIT_DOOR
+};
+
+static SpatialGrid grid;
+
+// Needs WORLD_HEIGHT, so it runs once the background is loaded
+static void buildGrid() {
+    grid.clear();
+    for (const SDL_Rect& wall : walls) grid.insert(wall, SOLID);
+    for (int i = 0; i < int(sizeof(doors) / sizeof(doors[0])); ++i) {
+        const Door& door = doors[i];
+        grid.insert(door.rect, SOLID | DOOR, i);
+        grid.insert({door.reachMinX + 1, 0, door.reachMaxX - door.reachMinX - 1, WORLD_HEIGHT}, REACH, i);
+    }
+}
 
 static bool loadMedia(SDL_Renderer* renderer) {
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"); // Smooth scaling
 
-    backgroundTexture = IMG_LoadTexture(renderer, "assets/images/floor1.png");
-    playerTexture = IMG_LoadTexture(renderer, "assets/images/player.png");
-    moveSfx = Mix_LoadWAV("assets/audio/robot.mp3");
+    bool haveBackground = background.open(renderer, BACKGROUND_TILES, BACKGROUND_IMAGE);
+    playerTexture = TextureCache::instance().acquire(renderer, "assets/images/player.png");
+    moveSfx = SoundBank::instance().get("assets/audio/robot.mp3");
 
-    if (!backgroundTexture || !playerTexture || !moveSfx) {
+    if (!haveBackground || !playerTexture || !moveSfx) {
         std::cerr << "Failed to load assets\n";
         return false;
     }
 
-    SDL_QueryTexture(backgroundTexture, NULL, NULL, &WORLD_WIDTH, &WORLD_HEIGHT);
+    WORLD_WIDTH = background.width();
+    WORLD_HEIGHT = background.height();
+    buildGrid();
     return true;
 }
 
@@ -58,19 +91,10 @@ static bool canMove(int x, int y) {
     tempPlayer.x += x;
     tempPlayer.y += y;
 
-    for (int i = 0; i < redCount; i++)
-        if (SDL_HasIntersection(&tempPlayer, &obstacles[i])) return false;
-    for (int i = 0; i < count1; i++)
-        if (SDL_HasIntersection(&tempPlayer, &obstacles1[i])) return false;
-    for (int i = 0; i < count2; i++)
-        if (SDL_HasIntersection(&tempPlayer, &obstacles2[i])) return false;
-    for (int i = 0; i < count3; i++)
-        if (SDL_HasIntersection(&tempPlayer, &obstacles3[i])) return false;
-
-    return true;
+    return !grid.overlapsAny(tempPlayer, SOLID);
 }
 
-static void handleInput(SDL_Event& e) {
+static void handleInput(const SDL_Event& e) {
     if (e.type == SDL_KEYDOWN) {
         bool canMovePlayer = true;
         int dx = 0, dy = 0;
@@ -100,134 +124,123 @@ static void updateCamera() {
 
 static void render(SDL_Renderer* renderer, TTF_Font* font, SDL_Rect quitBtn) {
     SDL_RenderClear(renderer);
-    SDL_Rect bgSrcRect = camera;
-    SDL_Rect bgDstRect = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_RenderCopy(renderer, backgroundTexture, &bgSrcRect, &bgDstRect);
+    background.stream(camera);
+    background.draw(renderer, camera);
 
     SDL_Rect playerOnScreen = {player.x - camera.x, player.y - camera.y, player.w, player.h};
     SDL_RenderCopy(renderer, playerTexture, NULL, &playerOnScreen);
 
     SDL_SetRenderDrawColor(renderer, 200, 0, 0, 255);
     SDL_RenderFillRect(renderer, &quitBtn);
-    SDL_Color white = {255,255,255};
-    SDL_Rect r;
-    SDL_Texture* txt = renderText(renderer, font, "Quit", white, r,0);
-    r.x = quitBtn.x + 20;
-    r.y = quitBtn.y + 8;
-    SDL_RenderCopy(renderer, txt, nullptr, &r);
-    SDL_DestroyTexture(txt);
-
-    SDL_RenderPresent(renderer);
+    SDL_Color white = {255,255,255,255};
+    drawText(renderer, font, "Quit", white, quitBtn.x + 20, quitBtn.y + 8);
 }
 
 static void cleanUp() {
-    SDL_DestroyTexture(backgroundTexture);
-    SDL_DestroyTexture(playerTexture);
-    if (moveSfx) Mix_FreeChunk(moveSfx);
-    backgroundTexture = nullptr;
-    playerTexture = nullptr;
+    background.close();
+    playerTexture.reset();
     moveSfx = nullptr;
 }
 
-static void runPuzzle1(SDL_Renderer* renderer) {
-    SDL_Color color = {255, 255, 255};
-    TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 36);
-    SDL_Surface* surface = TTF_RenderText_Solid(font, "Door Opened!", color);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect msgRect = {250, 250, 300, 100};
-    SDL_RenderCopy(renderer, texture, nullptr, &msgRect);
-    SDL_RenderPresent(renderer);
-    SDL_Delay(1500);
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
-    TTF_CloseFont(font);
-
-    if(runPuzzleGame(renderer)) {
-        puzzleSolved = true;
+static void handleClick(int mx, int my, SDL_Renderer* renderer, SceneStack& stack) {
+    // A door opens when clicked with the player standing in its reach
+    int hit = grid.firstAt(mx + camera.x, my + camera.y, DOOR);
+    if (hit < 0) return;
+    int door = grid.value(hit);
+    if (!grid.overlapsValue({player.x, player.y, 1, 1}, REACH, door)) return;
+
+    // Door 1 (Puzzle Game)
+    if (door == PUZZLE_DOOR) {
+        stack.push(std::make_unique<MessageScene>(renderer, "Door Opened!", SDL_Color{255, 255, 255, 255}, true),
+                   [renderer, &stack](bool) {
+                       stack.push(createPuzzleScene(renderer), [](bool solved) {
+                           if (solved) puzzleSolved = true;
+                       });
+                   });
     }
-}
 
-static void runRSAFromDoor2(SDL_Renderer* renderer) {
-    runRSAGame(renderer);  // No changes to logic here
-    if (rsaSolved) {  // Check that RSA game was solved
-        rsaSolved = true;
+    // Door 2 (RSA Game) - opens only if puzzle is solved
+    if (door == RSA_DOOR && puzzleSolved)
+        stack.push(createRSAScene(renderer));
+
+    // Door 3 (Unlocked after RSA is solved)
+    if (door == EXIT_DOOR && rsaSolved) {
+        stack.push(std::make_unique<MessageScene>(renderer, "Door 3 Unlocked!", SDL_Color{255, 255, 0, 255}, true),
+                   [](bool) { advanceToNextFloor(); });
     }
 }
 
+// ----------------------------------------------------
+// Floor1Scene keeps the floor's state in the statics above, so it survives
+// while a door's minigame runs on top of it.
+// ----------------------------------------------------
+class Floor1Scene : public Scene {
+public:
+    explicit Floor1Scene(GameContext& ctx) : ctx(ctx) {}
+
+    void enter() override {
+        player = {50, 100, 64, 64};
+        font = FontRegistry::instance().get("arial.ttf", 24);
+        if (!loadMedia(ctx.renderer) || !font) ctx.nextState = MENU;
+        else updateCamera();
+    }
 
+    void exit() override { cleanUp(); }
 
+    void handleEvent(const SDL_Event& e) override {
+        handleInput(e);
 
+        if (e.type == SDL_MOUSEBUTTONDOWN) {
+            int mx = e.button.x, my = e.button.y;
 
-static void handleClick(int mx, int my, SDL_Renderer* renderer) {
-    SDL_Rect clickPoint = {mx + camera.x, my + camera.y, 1, 1};
-
-    // Door 1 (Puzzle Game) - opens only if clicked on obstacles1
-    for (int i = 0; i < count1; i++)
-        if (SDL_HasIntersection(&clickPoint, &obstacles1[i])  && player.x > 210 && player.x < 296) runPuzzle1(renderer);
-
-    // Door 2 (RSA Game) - opens only if puzzle is solved
-    for (int i = 0; i < count2; i++)
-        if (puzzleSolved && SDL_HasIntersection(&clickPoint, &obstacles2[i]) && player.x > 445 && player.x < 535 ) runRSAFromDoor2(renderer);
+            if (mx >= quitBtn.x && mx <= quitBtn.x + quitBtn.w &&
+                my >= quitBtn.y && my <= quitBtn.y + quitBtn.h) {
+                ctx.nextState = MENU;
+                return;
+            }
 
-    // Door 3 (Unlocked after RSA is solved)
-    for (int i = 0; i < count3; i++)
-        if (rsaSolved && SDL_HasIntersection(&clickPoint, &obstacles3[i])   && player.x > 706 && player.x < 793 ) {
-            SDL_Color color = {255, 255, 0};
-            TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 36);
-            SDL_Surface* surface = TTF_RenderText_Solid(font, "Door 3 Unlocked!", color);
-            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-            SDL_Rect msgRect = {250, 250, 300, 100};
-            SDL_RenderCopy(renderer, texture, nullptr, &msgRect);
-            SDL_RenderPresent(renderer);
-            SDL_Delay(1500);
-            SDL_FreeSurface(surface);
-            SDL_DestroyTexture(texture);
-            TTF_CloseFont(font);
-            advanceToNextFloor();
+            handleClick(mx, my, ctx.renderer, stack());
         }
-}
-
-void runFloor1(GameContext& ctx) {
-    SDL_Renderer* renderer = ctx.renderer;
-    player = {50, 100, 64, 64};
-    if (!loadMedia(renderer)) return;
-
-    SDL_Rect quitBtn = {20, 20, 100, 40};
-    TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 24);
-    if (!font) return;
+    }
 
-    bool quit = false;
-    SDL_Event e;
+    // The camera follows the player here rather than in render(): a fast
+    // replay never renders, and clicks are mapped through the camera
+    void update(double step) override { updateCamera(); }
 
-    while (!quit) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                SDL_Quit();
-                exit(0);
-            }
+    void render(SDL_Renderer* renderer, float alpha) override {
+        ::render(renderer, font, quitBtn);
+    }
 
-            handleInput(e);
+    // Only moves on key presses, so it can sleep between events once the
+    // background tiles around the robot have arrived
+    int redrawIntervalMs() const override {
+        return background.isStreaming() ? 0 : FrameScheduler::IDLE_WAKE_MS;
+    }
 
-            if (e.type == SDL_MOUSEBUTTONDOWN) {
-                int mx, my;
-                SDL_GetMouseState(&mx, &my);
+private:
+    GameContext& ctx;
+    TTF_Font* font = nullptr;
+    SDL_Rect quitBtn = {20, 20, 100, 40};
+};
 
-                if (mx >= quitBtn.x && mx <= quitBtn.x + quitBtn.w &&
-                    my >= quitBtn.y && my <= quitBtn.y + quitBtn.h) {
-                    ctx.nextState = MENU;
-                    quit = true;
-                    break;
-                }
+std::unique_ptr<Scene> createFloor1Scene(GameContext& ctx) {
+    return std::make_unique<Floor1Scene>(ctx);
+}
 
-                handleClick(mx, my, renderer);
-                if (getCurrentFloor() != 1) quit = true;
+const AssetList& floor1Assets() {
+    static const AssetList assets = [] {
+        AssetList list = {
+            {
+                "assets/images/player.png",
+                "assets/images/puzzleimage.png", "assets/images/decryptor.png",
+                "assets/images/rsa_background.png"
+            },
+            {
+                "assets/audio/robot.mp3", "assets/audio/correct.mp3", "assets/audio/wrong.mp3"
             }
-        }
-
-        updateCamera();
-        render(renderer, font, quitBtn);
-    }
-
-    TTF_CloseFont(font);
-    cleanUp();
-}
\ No newline at end of file
+        };
+        TiledBackground::appendTiles(list, BACKGROUND_TILES, BACKGROUND_IMAGE);
+        return list;
+    }();
+    return assets;
+}
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <memory>
 #include "../../common/GameContext.h"
+#include "../../common/scene.h"
 
-// Original signature before GameState integration
-void runFloor1(GameContext& ctx);
+struct AssetList;
+
+// Floor 1 scene; its doors push the puzzle and RSA minigames
+std::unique_ptr<Scene> createFloor1Scene(GameContext& ctx);
+
+// Images and sounds the floor and its minigames use, for AssetLoader
+const AssetList& floor1Assets();
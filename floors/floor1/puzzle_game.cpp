@@ -5,8 +5,15 @@
 #include <SDL2/SDL_mixer.h>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include "../../common/utils.h"
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/scene.h"
 #include "rsa_game.h"
 #include "../../common/game_state.h"
 
@@ -20,170 +27,166 @@ struct Puzzle {
     string question;
     string answer;
 };
-bool runPuzzleGame(SDL_Renderer* renderer) {
-    TTF_Font* font = TTF_OpenFont("assets/fonts/impact.ttf", 24);
-    if (!font) return false;
-
-    SDL_Texture* bgTexture = loadTexture(renderer, "assets/images/puzzleimage.png");
-    SDL_Texture* decryptTex = loadTexture(renderer, "assets/images/decryptor.png");
-    Mix_Music* bgm = Mix_LoadMUS("assets/audio/puzzleGame.wav");
-    Mix_Chunk* correctSfx = Mix_LoadWAV("assets/audio/correct.mp3");
-    Mix_Chunk* wrongSfx = Mix_LoadWAV("assets/audio/wrong.mp3");
-
-    if (bgm) Mix_PlayMusic(bgm, -1);
-
-    SDL_Color white = {255, 255, 255, 255};
-    SDL_Event e;
+// ----------------------------------------------------
+// PuzzleScene: click the monitor to start, then answer each riddle before
+// the countdown runs out. The decryptor image is shown for two seconds
+// after the last answer.
+// ----------------------------------------------------
+class PuzzleScene : public Scene {
+public:
+    explicit PuzzleScene(SDL_Renderer* renderer) : renderer(renderer) {}
+
+    void enter() override {
+        font = FontRegistry::instance().get("impact.ttf", 24);
+        if (!font) {
+            finish(false);
+            return;
+        }
 
-    vector<Puzzle> puzzles = {
-        {"I have keys but no locks, I have space but no room. What am I?", "keyboard"},
-        {"What has to be broken before you use it?", "egg"},
-        {"Crimson frames hold knowledge tight,\nWhere daylight meets the scholar's light.", "curzon"}
-    };
+        bgTexture = TextureCache::instance().acquire(renderer, "assets/images/puzzleimage.png");
+        decryptTex = TextureCache::instance().acquire(renderer, "assets/images/decryptor.png");
+        bgm = Mix_LoadMUS("assets/audio/puzzleGame.wav");
+        correctSfx = SoundBank::instance().get("assets/audio/correct.mp3");
+        wrongSfx = SoundBank::instance().get("assets/audio/wrong.mp3");
 
-    int currentPuzzle = -1;
-    bool running = true, puzzleStarted = false, puzzleSolved = false;
-    Uint32 puzzleStartTime = 0;
-    string userInput;
-    SDL_Rect monitorTouchArea = {320, 256, 512, 320};
+        if (bgm) Mix_PlayMusic(bgm, -1);
+    }
 
-    while (running) {
-        if (puzzleStarted && !SDL_IsTextInputActive()) SDL_StartTextInput();
-        if ((!puzzleStarted || puzzleSolved) && SDL_IsTextInputActive()) SDL_StopTextInput();
-
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                // Full cleanup
-                Mix_HaltMusic();
-                Mix_FreeMusic(bgm);
-                Mix_FreeChunk(correctSfx);
-                Mix_FreeChunk(wrongSfx);
-                SDL_DestroyTexture(bgTexture);
-                SDL_DestroyTexture(decryptTex);
-                TTF_CloseFont(font);
-                SDL_StopTextInput();
-                return false;
-            }
+    void exit() override {
+        SDL_StopTextInput();
+        if (bgm) {
+            Mix_HaltMusic();
+            Mix_FreeMusic(bgm);
+            bgm = nullptr;
+        }
+    }
 
-            if (!puzzleStarted && e.type == SDL_MOUSEBUTTONDOWN) {
-                int mx, my; SDL_GetMouseState(&mx, &my);
-                if (mx >= monitorTouchArea.x && mx <= monitorTouchArea.x + monitorTouchArea.w &&
-                    my >= monitorTouchArea.y && my <= monitorTouchArea.y + monitorTouchArea.h) {
-                    currentPuzzle = 0;
-                    puzzleStarted = true;
-                    puzzleSolved = false;
-                    userInput.clear();
-                    puzzleStartTime = SDL_GetTicks();
-                }
+    void handleEvent(const SDL_Event& e) override {
+        if (showingDecryptor || timedOut) return;
+
+        if (!puzzleStarted && e.type == SDL_MOUSEBUTTONDOWN) {
+            int mx = e.button.x, my = e.button.y;
+            if (mx >= monitorTouchArea.x && mx <= monitorTouchArea.x + monitorTouchArea.w &&
+                my >= monitorTouchArea.y && my <= monitorTouchArea.y + monitorTouchArea.h) {
+                currentPuzzle = 0;
+                puzzleStarted = true;
+                puzzleSolved = false;
+                userInput.clear();
+                puzzleStartTime = FrameScheduler::gameTicks();
             }
+        }
 
-            if (puzzleStarted && !puzzleSolved) {
-                if (e.type == SDL_TEXTINPUT) userInput += e.text.text;
-                if (e.type == SDL_KEYDOWN) {
-                    if (e.key.keysym.sym == SDLK_BACKSPACE && !userInput.empty()) userInput.pop_back();
-                    else if (e.key.keysym.sym == SDLK_RETURN) {
-                        if (userInput == puzzles[currentPuzzle].answer) {
-                            Mix_PlayChannel(-1, correctSfx, 0);
-                            puzzleSolved = true;  // Only set this to true if the answer is correct
-                        }
+        if (puzzleStarted && !puzzleSolved) {
+            if (e.type == SDL_TEXTINPUT) userInput += e.text.text;
+            if (e.type == SDL_KEYDOWN) {
+                if (e.key.keysym.sym == SDLK_BACKSPACE && !userInput.empty()) userInput.pop_back();
+                else if (e.key.keysym.sym == SDLK_RETURN) {
+                    if (userInput == puzzles[currentPuzzle].answer) {
+                        Mix_PlayChannel(-1, correctSfx, 0);
+                        puzzleSolved = true;  // Only set this to true if the answer is correct
                     }
                 }
             }
+        }
 
-            if (puzzleSolved && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE) {
-                currentPuzzle++;
-                if (currentPuzzle < (int)puzzles.size()) {
-                    puzzleStarted = true;
-                    puzzleSolved = false;
-                    userInput.clear();
-                    puzzleStartTime = SDL_GetTicks();
-                } else {
-                    SDL_StopTextInput();
-                    running = false;
-                }
+        if (puzzleSolved && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE) {
+            currentPuzzle++;
+            if (currentPuzzle < (int)puzzles.size()) {
+                puzzleStarted = true;
+                puzzleSolved = false;
+                userInput.clear();
+                puzzleStartTime = FrameScheduler::gameTicks();
+            } else if (decryptTex) {
+                showingDecryptor = true;
+                holdTimer = 2.0;
+            } else {
+                finish(true);
             }
         }
+    }
 
-        if (puzzleStarted && !puzzleSolved) {
-            Uint32 now = SDL_GetTicks();
-            int secondsLeft = PUZZLE_TIME_LIMIT - (now - puzzleStartTime) / 1000;
-            if (secondsLeft <= 0) {
-                Mix_PlayChannel(-1, wrongSfx, 0);
-                SDL_Delay(1500);
-                SDL_StopTextInput();
-                SDL_DestroyTexture(bgTexture);
-                SDL_DestroyTexture(decryptTex);
-                TTF_CloseFont(font);
-                Mix_HaltMusic();
-                Mix_FreeMusic(bgm);
-                Mix_FreeChunk(correctSfx);
-                Mix_FreeChunk(wrongSfx);
-                return false;  // Return false if time runs out
-            }
+    void update(double dt) override {
+        bool typing = puzzleStarted && !puzzleSolved && !timedOut && !showingDecryptor;
+        if (typing && !SDL_IsTextInputActive()) SDL_StartTextInput();
+        if (!typing && SDL_IsTextInputActive()) SDL_StopTextInput();
+
+        if (showingDecryptor || timedOut) {
+            holdTimer -= dt;
+            if (holdTimer <= 0.0) finish(showingDecryptor);  // true once solved, false after a timeout
+            return;
+        }
+
+        if (typing && secondsLeft() <= 0) {
+            Mix_PlayChannel(-1, wrongSfx, 0);
+            timedOut = true;
+            holdTimer = 1.5;
+        }
+    }
+
+    void render(SDL_Renderer* renderer, float alpha) override {
+        if (showingDecryptor) {
+            SDL_RenderClear(renderer);
+            SDL_RenderCopy(renderer, decryptTex, nullptr, nullptr);
+            return;
         }
 
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
         if (bgTexture) SDL_RenderCopy(renderer, bgTexture, nullptr, nullptr);
 
-        SDL_Rect r; SDL_Texture* txt = nullptr;
+        const int wrap = 800;
+        string message;
+        int messageY = 100;
         if (!puzzleStarted) {
-            txt = renderText(renderer, font, "Click screen to start puzzle. Use lowercase answers only.", white, r);
-            r.x = (SCREEN_WIDTH - r.w) / 2;
-            r.y = SCREEN_HEIGHT - 300;
+            message = "Click screen to start puzzle. Use lowercase answers only.";
+            messageY = SCREEN_HEIGHT - 300;
         } else if (puzzleSolved) {
-            txt = renderText(renderer, font, "Correct! Press SPACE for next puzzle.", white, r);
-            r.x = (SCREEN_WIDTH - r.w) / 2;
-            r.y = 100;
+            message = "Correct! Press SPACE for next puzzle.";
         } else {
-            Uint32 now = SDL_GetTicks();
-            int secondsLeft = PUZZLE_TIME_LIMIT - (now - puzzleStartTime) / 1000;
-            string full = puzzles[currentPuzzle].question + "\nYour Answer: " + userInput +
-                          "\nTime Left: " + to_string(secondsLeft);
-            txt = renderText(renderer, font, full, white, r);
-            r.x = (SCREEN_WIDTH - r.w) / 2;
-            r.y = 100;
+            message = puzzles[currentPuzzle].question + "\nYour Answer: " + userInput +
+                      "\nTime Left: " + to_string(std::max(0, secondsLeft()));
         }
 
-        if (txt) {
-            SDL_RenderCopy(renderer, txt, nullptr, &r);
-            SDL_DestroyTexture(txt);
-        }
+        SDL_Rect r = measureText(renderer, font, message, wrap);
+        drawText(renderer, font, message, white, (SCREEN_WIDTH - r.w) / 2, messageY, wrap);
+    }
 
-        SDL_RenderPresent(renderer);
+    // Redraw on input, and on each tick of the countdown while it shows
+    int redrawIntervalMs() const override {
+        if (showingDecryptor || timedOut) return 0;
+        if (puzzleStarted && !puzzleSolved) return 1000 - (FrameScheduler::gameTicks() - puzzleStartTime) % 1000;
+        return FrameScheduler::IDLE_WAKE_MS;
     }
 
-    // Show decryptor image for 2 seconds
-    if (decryptTex) {
-        Uint32 start = SDL_GetTicks();
-        while (SDL_GetTicks() - start < 2000) {
-            SDL_Event ev;
-            while (SDL_PollEvent(&ev)) {
-                if (ev.type == SDL_QUIT) {
-                    Mix_HaltMusic();
-                    Mix_FreeMusic(bgm);
-                    Mix_FreeChunk(correctSfx);
-                    Mix_FreeChunk(wrongSfx);
-                    SDL_DestroyTexture(bgTexture);
-                    SDL_DestroyTexture(decryptTex);
-                    TTF_CloseFont(font);
-                    return false;
-                }
-            }
-            SDL_RenderClear(renderer);
-            SDL_RenderCopy(renderer, decryptTex, nullptr, nullptr);
-            SDL_RenderPresent(renderer);
-            SDL_Delay(16);
-        }
+private:
+    int secondsLeft() const {
+        return PUZZLE_TIME_LIMIT - (FrameScheduler::gameTicks() - puzzleStartTime) / 1000;
     }
 
-    SDL_DestroyTexture(bgTexture);
-    SDL_DestroyTexture(decryptTex);
-    TTF_CloseFont(font);
-    Mix_HaltMusic();
-    Mix_FreeMusic(bgm);
-    Mix_FreeChunk(correctSfx);
-    Mix_FreeChunk(wrongSfx);
+    SDL_Renderer* renderer;
+    TTF_Font* font = nullptr;
+    TextureHandle bgTexture;
+    TextureHandle decryptTex;
+    Mix_Music* bgm = nullptr;
+    Mix_Chunk* correctSfx = nullptr;
+    Mix_Chunk* wrongSfx = nullptr;
+
+    SDL_Color white = {255, 255, 255, 255};
+    vector<Puzzle> puzzles = {
+        {"I have keys but no locks, I have space but no room. What am I?", "keyboard"},
+        {"What has to be broken before you use it?", "egg"},
+        {"Crimson frames hold knowledge tight,\nWhere daylight meets the scholar's light.", "curzon"}
+    };
+
+    int currentPuzzle = -1;
+    bool puzzleStarted = false, puzzleSolved = false;
+    bool timedOut = false, showingDecryptor = false;
+    double holdTimer = 0.0;
+    Uint32 puzzleStartTime = 0;
+    string userInput;
+    SDL_Rect monitorTouchArea = {320, 256, 512, 320};
+};
 
-    return true;  // Return true if the puzzle is successfully solved
-}
\ No newline at end of file
+std::unique_ptr<Scene> createPuzzleScene(SDL_Renderer* renderer) {
+    return std::make_unique<PuzzleScene>(renderer);
+}
@@ -2,7 +2,10 @@
 #define PUZZLE_GAME_H
 
 #include <SDL2/SDL.h>
+#include <memory>
+#include "../../common/scene.h"
 
-bool runPuzzleGame(SDL_Renderer* renderer);
+// Riddle minigame; finishes with true once every riddle is answered
+std::unique_ptr<Scene> createPuzzleScene(SDL_Renderer* renderer);
 
 #endif
@@ -2,6 +2,10 @@
 #define RSA_GAME_H
 
 #include <SDL2/SDL.h>
-void runRSAGame(SDL_Renderer* renderer);
+#include <memory>
+#include "../../common/scene.h"
+
+// RSA decryption minigame; sets rsaSolved once the door code is found
+std::unique_ptr<Scene> createRSAScene(SDL_Renderer* renderer);
 
 #endif // RSA_GAME_H
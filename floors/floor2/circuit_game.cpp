@@ -7,10 +7,15 @@
 #include <string>
 #include <sstream>
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
 #include "../../common/GameContext.h"
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/rng.h"
+#include "../../common/scene.h"
 
 
 const int WIN_W = 800, WIN_H = 600;
@@ -31,82 +36,79 @@ bool isNear(int x1, int y1, int x2, int y2, int range = 40) {
     return (std::abs(x1 - x2) < range && std::abs(y1 - y2) < range);
 }
 
-void runCircuitGame(SDL_Renderer* ren, GameContext& ctx) {
-    TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 24);
-    SDL_Texture* background = IMG_LoadTexture(ren, "assets/images/circuit_background.png");
-    SDL_Texture* ledTex = IMG_LoadTexture(ren, "assets/images/led.png");
+// ----------------------------------------------------
+// CircuitScene: drag each component onto its slot before time runs out.
+// SPACE pauses the clock. Finishes as soon as the board is solved or the
+// time is up.
+// ----------------------------------------------------
+class CircuitScene : public Scene {
+public:
+    CircuitScene(SDL_Renderer* ren, GameContext& ctx) : ren(ren), ctx(ctx) {}
 
-    SDL_Texture* compTex[COMP_COUNT];
-    for (int i = 0; i < COMP_COUNT; ++i) {
-        compTex[i] = IMG_LoadTexture(ren, fileNames[i]);
-    }
+    void enter() override {
+        font = FontRegistry::instance().get("arial.ttf", 24);
+        background = TextureCache::instance().acquire(ren, "assets/images/circuit_background.png");
+        ledTex = TextureCache::instance().acquire(ren, "assets/images/led.png");
+
+        for (int i = 0; i < COMP_COUNT; ++i) {
+            compTex[i] = TextureCache::instance().acquire(ren, fileNames[i]);
+        }
 
-    Mix_Chunk* pickSound    = Mix_LoadWAV("assets/audio/pick.mp3");
-    Mix_Chunk* placeSound   = Mix_LoadWAV("assets/audio/place.mp3");
-    Mix_Chunk* successSound = Mix_LoadWAV("assets/audio/success_circuit.mp3");
-    Mix_Chunk* failSound    = Mix_LoadWAV("assets/audio/fail_circuit.mp3");
+        SoundBank& sounds = SoundBank::instance();
+        pickSound    = sounds.get("assets/audio/pick.mp3");
+        placeSound   = sounds.get("assets/audio/place.mp3");
+        successSound = sounds.get("assets/audio/success_circuit.mp3");
+        failSound    = sounds.get("assets/audio/fail_circuit.mp3");
 
-    struct Comp { SDL_Rect rect; bool placed; };
-    std::vector<Comp> comps(COMP_COUNT);
-    for (int i = 0; i < COMP_COUNT; ++i) {
-        comps[i].rect = {100 + i * 100, 400, 64, 64};
-        comps[i].placed = false;
+        comps.resize(COMP_COUNT);
+        for (int i = 0; i < COMP_COUNT; ++i) {
+            comps[i].rect = {100 + i * 100, 400, 64, 64};
+            comps[i].placed = false;
+        }
+
+        startTicks = FrameScheduler::gameTicks();
+        SDL_StartTextInput();
     }
 
-    bool quit = false, paused = false, solved = false;
-    bool dragging = false;
-    int dragged = -1, offsetX = 0, offsetY = 0;
+    void exit() override { SDL_StopTextInput(); }
 
-    Uint32 startTicks = SDL_GetTicks();
-    Uint32 pausedTicks = 0;
-    const int TIME_LIMIT = 60;
-    std::string unlockMsg;
+    void handleEvent(const SDL_Event& e) override {
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE && !solved) {
+            paused = !paused;
+            if (paused) pausedTicks = FrameScheduler::gameTicks() - startTicks;
+            else startTicks = FrameScheduler::gameTicks() - pausedTicks;
+        }
 
-    SDL_StartTextInput();
-    while (!quit && !solved) {
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) { quit = true; break; }
-            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE && !solved) {
-                paused = !paused;
-                if (paused) pausedTicks = SDL_GetTicks() - startTicks;
-                else startTicks = SDL_GetTicks() - pausedTicks;
-            }
+        if (paused || solved) return;
 
-            if (!paused && !solved) {
-                if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
-                    int mx = e.button.x, my = e.button.y;
-                    for (int i = 0; i < COMP_COUNT; ++i) {
-                        SDL_Rect& r = comps[i].rect;
-                        if (mx > r.x && mx < r.x + r.w && my > r.y && my < r.y + r.h) {
-                            dragging = true; dragged = i;
-                            offsetX = mx - r.x; offsetY = my - r.y;
-                            Mix_PlayChannel(-1, pickSound, 0);
-                            break;
-                        }
-                    }
-                }
-                if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
-                    if (dragged != -1 && isNear(comps[dragged].rect.x, comps[dragged].rect.y,
-                                                targetSlots[dragged].x, targetSlots[dragged].y)) {
-                        Mix_PlayChannel(-1, placeSound, 0);
-                    }
-                    dragging = false; dragged = -1;
-                }
-                if (e.type == SDL_MOUSEMOTION && dragging && dragged != -1) {
-                    comps[dragged].rect.x = e.motion.x - offsetX;
-                    comps[dragged].rect.y = e.motion.y - offsetY;
+        if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+            int mx = e.button.x, my = e.button.y;
+            for (int i = 0; i < COMP_COUNT; ++i) {
+                SDL_Rect& r = comps[i].rect;
+                if (mx > r.x && mx < r.x + r.w && my > r.y && my < r.y + r.h) {
+                    dragging = true; dragged = i;
+                    offsetX = mx - r.x; offsetY = my - r.y;
+                    Mix_PlayChannel(-1, pickSound, 0);
+                    break;
                 }
             }
         }
-
-        Uint32 now = SDL_GetTicks();
-        int secLeft;
-        if (paused || solved) secLeft = TIME_LIMIT - (int)(pausedTicks / 1000);
-        else {
-            pausedTicks = now - startTicks;
-            secLeft = TIME_LIMIT - (int)(pausedTicks / 1000);
+        if (e.type == SDL_MOUSEBUTTONUP && e.button.button == SDL_BUTTON_LEFT) {
+            if (dragged != -1 && isNear(comps[dragged].rect.x, comps[dragged].rect.y,
+                                        targetSlots[dragged].x, targetSlots[dragged].y)) {
+                Mix_PlayChannel(-1, placeSound, 0);
+            }
+            dragging = false; dragged = -1;
         }
+        if (e.type == SDL_MOUSEMOTION && dragging && dragged != -1) {
+            comps[dragged].rect.x = e.motion.x - offsetX;
+            comps[dragged].rect.y = e.motion.y - offsetY;
+        }
+    }
+
+    void update(double dt) override {
+        if (!paused && !solved) pausedTicks = FrameScheduler::gameTicks() - startTicks;
+        secLeft = TIME_LIMIT - (int)(pausedTicks / 1000);
 
         if (!paused && !solved && secLeft <= 0) {
             solved = true; unlockMsg = "Time's up! Try again.";
@@ -122,12 +124,19 @@ void runCircuitGame(SDL_Renderer* ren, GameContext& ctx) {
             }
             if (allPlaced) {
                 solved = true;
-                int keyNum = 1000 + std::rand() % 9000;
+                int keyNum = RngService::instance().stream(RngService::CIRCUIT).range(1000, 9999);
                 unlockMsg = "Puzzle Solved! Unlock Key: " + std::to_string(keyNum);
                 Mix_PlayChannel(-1, successSound, 0);
             }
         }
 
+        if (solved) {
+            ctx.nextState = FLOOR1;
+            finish(true);
+        }
+    }
+
+    void render(SDL_Renderer* ren, float alpha) override {
         SDL_SetRenderDrawColor(ren, 20, 20, 20, 255);
         SDL_RenderClear(ren);
 
@@ -149,39 +158,47 @@ void runCircuitGame(SDL_Renderer* ren, GameContext& ctx) {
         if (font) {
             std::stringstream ss;
             ss << "Time Left: " << (secLeft > 0 ? secLeft : 0) << "s";
-            SDL_Surface* ts = TTF_RenderText_Blended(font, ss.str().c_str(), {0, 0, 0, 255});
-            if (ts) {
-                SDL_Texture* tt = SDL_CreateTextureFromSurface(ren, ts);
-                SDL_Rect tr = {10, 10, ts->w, ts->h};
-                SDL_RenderCopy(ren, tt, NULL, &tr);
-                SDL_FreeSurface(ts);
-                SDL_DestroyTexture(tt);
-            }
+            drawText(ren, font, ss.str(), {0, 0, 0, 255}, 10, 10);
         }
 
         if (solved && font) {
-            SDL_Surface* rs = TTF_RenderText_Blended(font, unlockMsg.c_str(), {255, 255, 255, 255});
-            if (rs) {
-                SDL_Texture* rt = SDL_CreateTextureFromSurface(ren, rs);
-                SDL_Rect rr = {150, 500, rs->w, rs->h};
-                SDL_RenderCopy(ren, rt, NULL, &rr);
-                SDL_FreeSurface(rs);
-                SDL_DestroyTexture(rt);
-            }
+            drawText(ren, font, unlockMsg, {255, 255, 255, 255}, 150, 500);
         }
+    }
 
-        SDL_RenderPresent(ren);
-        SDL_Delay(16);
+    // Dragging redraws through events; otherwise only the clock changes
+    int redrawIntervalMs() const override {
+        if (paused) return FrameScheduler::IDLE_WAKE_MS;
+        return 1000 - (FrameScheduler::gameTicks() - startTicks) % 1000;
     }
-    if (solved) ctx.nextState = FLOOR1;
-    Mix_FreeChunk(pickSound);
-    Mix_FreeChunk(placeSound);
-    Mix_FreeChunk(successSound);
-    Mix_FreeChunk(failSound);
-    TTF_CloseFont(font);
-    for (int i = 0; i < COMP_COUNT; ++i) SDL_DestroyTexture(compTex[i]);
-    SDL_DestroyTexture(ledTex);
-    SDL_DestroyTexture(background);
-    SDL_StopTextInput();
-    return;
-}
\ No newline at end of file
+
+private:
+    static const int TIME_LIMIT = 60;
+
+    SDL_Renderer* ren;
+    GameContext& ctx;
+    TTF_Font* font = nullptr;
+    TextureHandle background;
+    TextureHandle ledTex;
+    TextureHandle compTex[COMP_COUNT];
+    Mix_Chunk* pickSound = nullptr;
+    Mix_Chunk* placeSound = nullptr;
+    Mix_Chunk* successSound = nullptr;
+    Mix_Chunk* failSound = nullptr;
+
+    struct Comp { SDL_Rect rect; bool placed; };
+    std::vector<Comp> comps;
+
+    bool paused = false, solved = false;
+    bool dragging = false;
+    int dragged = -1, offsetX = 0, offsetY = 0;
+
+    Uint32 startTicks = 0;
+    Uint32 pausedTicks = 0;
+    int secLeft = TIME_LIMIT;
+    std::string unlockMsg;
+};
+
+std::unique_ptr<Scene> createCircuitScene(SDL_Renderer* ren, GameContext& ctx) {
+    return std::make_unique<CircuitScene>(ren, ctx);
+}
@@ -2,10 +2,11 @@
 #define CIRCUIT_GAME_H
 
 #include <SDL2/SDL.h>
+#include <memory>
 #include "../../common/GameContext.h"
+#include "../../common/scene.h"
 
-// Run the circuit game using the shared SDL_Renderer.
-// Should be launched in a thread from floor2.cpp.
-void runCircuitGame(SDL_Renderer* sharedRenderer,GameContext& ctx);
+// Circuit game on the shared SDL_Renderer, pushed from floor2.cpp
+std::unique_ptr<Scene> createCircuitScene(SDL_Renderer* sharedRenderer, GameContext& ctx);
 
 #endif // CIRCUIT_GAME_H
@@ -1,50 +1,92 @@
 #include "floor2.h"
 #include "../../common/game_state.h"
 #include "../../common/utils.h"
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/asset_loader.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/spatial_grid.h"
+#include "../../common/tiled_background.h"
 #include "../../common/GameContext.h"
+#include "../../UI/message_scene.h"
+#include "tetris_game.h"
+#include "circuit_game.h"
+#include "projection_game.h"
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
 #include <iostream>
 #include <algorithm>
 
-bool runTetrisGame(SDL_Renderer* renderer);
-void runCircuitGame(SDL_Renderer* renderer,GameContext& ctx);
-void runProjectionGame(SDL_Renderer* renderer);
-
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
 
 static SDL_Rect player = {480, 700, 50, 50};
 static SDL_Rect camera = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-static SDL_Texture* backgroundTexture = nullptr;
-static SDL_Texture* playerTexture = nullptr;
+// Background tiles, or the whole image if `make tiles` has not run
+static const char* BACKGROUND_TILES = "assets/tiles/floor2";
+static const char* BACKGROUND_IMAGE = "assets/images/floor2.png";
+static TiledBackground background;
+static TextureHandle playerTexture;
 static Mix_Chunk* correctSound = nullptr;
 static Mix_Chunk* moveSfx = nullptr;
 
-static SDL_Rect door1 = {112, 85, 75, 120};
-static SDL_Rect door2 = {270, 85, 65, 120};
-static SDL_Rect door3 = {475, 85, 75, 120};
-static SDL_Rect door4 = {685, 85, 75, 120};
-static SDL_Rect obstacles[] = {{285, 265, 450, 370}};
 static SDL_Rect quitBtn = {20, 20, 100, 40};
 
 static int WORLD_WIDTH = 1600;
 static int WORLD_HEIGHT = 1200;
 
+// Kinds of rect in the floor's SpatialGrid
+enum : Uint32 { SOLID = 1, DOOR = 2, REACH = 4 };
+
+// A door blocks movement and can be used while player.x is strictly
+// between reachMinX and reachMaxX
+struct Door {
+    SDL_Rect rect;
+    int reachMinX, reachMaxX;
+};
+
+enum { TETRIS_DOOR, CIRCUIT_DOOR, PROJECTION_DOOR, EXIT_DOOR };
+
+static const SDL_Rect walls[] = {{285, 265, 450, 370}};
+static const Door doors[] = {
+    {{112, 85, 75, 120}, 95, 170},   // TETRIS_DOOR
+    {{270, 85, 65, 120}, 250, 315},  // CIRCUIT_DOOR
+    {{475, 85, 75, 120}, 455, 530},  // PROJECTION_DOOR
+    {{685, 85, 75, 120}, 665, 740},  // EXIT_DOOR
+};
+
+static SpatialGrid grid;
+
+// Needs WORLD_HEIGHT, so it runs once the background is loaded
+static void buildGrid() {
+    grid.clear();
+    for (const SDL_Rect& wall : walls) grid.insert(wall, SOLID);
+    for (int i = 0; i < int(sizeof(doors) / sizeof(doors[0])); ++i) {
+        const Door& door = doors[i];
+        grid.insert(door.rect, SOLID | DOOR, i);
+        grid.insert({door.reachMinX + 1, 0, door.reachMaxX - door.reachMinX - 1, WORLD_HEIGHT}, REACH, i);
+    }
+}
+
 static bool loadMedia(SDL_Renderer* renderer) {
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"); // Smooth scaling
 
-    backgroundTexture = IMG_LoadTexture(renderer, "assets/images/floor2.png");
-    playerTexture = IMG_LoadTexture(renderer, "assets/images/player.png");
-    moveSfx = Mix_LoadWAV("assets/audio/robot.mp3");
+    bool haveBackground = background.open(renderer, BACKGROUND_TILES, BACKGROUND_IMAGE);
+    playerTexture = TextureCache::instance().acquire(renderer, "assets/images/player.png");
+    correctSound = SoundBank::instance().get("assets/audio/correct.mp3");
+    moveSfx = SoundBank::instance().get("assets/audio/robot.mp3");
 
-    if (!backgroundTexture || !playerTexture || !moveSfx) {
+    if (!haveBackground || !playerTexture || !moveSfx) {
         std::cerr << "Failed to load assets\n";
         return false;
     }
 
-    SDL_QueryTexture(backgroundTexture, NULL, NULL, &WORLD_WIDTH, &WORLD_HEIGHT);
+    WORLD_WIDTH = background.width();
+    WORLD_HEIGHT = background.height();
+    buildGrid();
     return true;
 }
 
@@ -54,18 +96,14 @@ static bool canMove(int dx, int dy) {
     temp.x += dx;
     temp.y += dy;
 
-    if (SDL_HasIntersection(&temp, &obstacles[0])) return false;
-    if (SDL_HasIntersection(&temp, &door1)) return false;
-    if (SDL_HasIntersection(&temp, &door2)) return false;
-    if (SDL_HasIntersection(&temp, &door3)) return false;
-    if (SDL_HasIntersection(&temp, &door4)) return false;
+    if (grid.overlapsAny(temp, SOLID)) return false;
 
     return (temp.x >= 0 && temp.y >= 0 &&
             temp.x + temp.w <= WORLD_WIDTH &&
             temp.y + temp.h <= WORLD_HEIGHT);
 }
 
-static void handleInput(SDL_Event& e) {
+static void handleInput(const SDL_Event& e) {
     if (e.type == SDL_KEYDOWN) {
         int dx = 0, dy = 0;
         switch (e.key.keysym.sym) {
@@ -90,61 +128,52 @@ static void updateCamera() {
     camera.y = std::clamp(camera.y, 0, WORLD_HEIGHT - camera.h);
 }
 
-static void showMessage(SDL_Renderer* renderer, const std::string& text) {
-    TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 36);
-    if (!font) return;
-    SDL_Color color = {255, 255, 255};
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect rect = {250, 250, 300, 100};
-
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, texture, nullptr, &rect);
-    SDL_RenderPresent(renderer);
-
-    SDL_Delay(1500);
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
-    TTF_CloseFont(font);
+// Full-screen notice, then `then` once it has been shown
+static void showMessage(SceneStack& stack, SDL_Renderer* renderer, const std::string& text,
+                        SceneCallback then = nullptr) {
+    stack.push(std::make_unique<MessageScene>(renderer, text), std::move(then));
 }
 
 
-static void handleClick(int mx, int my, SDL_Renderer* renderer, bool& quit, GameContext& ctx) {
-    SDL_Rect click = {mx + camera.x, my + camera.y, 1, 1};
-
+static void handleClick(int mx, int my, SDL_Renderer* renderer, SceneStack& stack, GameContext& ctx) {
     if (mx >= quitBtn.x && mx <= quitBtn.x + quitBtn.w &&
         my >= quitBtn.y && my <= quitBtn.y + quitBtn.h) {
         ctx.nextState = MENU;
-        quit = true;
         return;
     }
 
-    if (!isTetrisSolved() && SDL_HasIntersection(&click, &door1)  && player.x > 95 && player.x < 170   ) {
+    // A door opens when clicked with the player standing in its reach
+    int hit = grid.firstAt(mx + camera.x, my + camera.y, DOOR);
+    if (hit < 0) return;
+    int door = grid.value(hit);
+    if (!grid.overlapsValue({player.x, player.y, 1, 1}, REACH, door)) return;
+
+    if (door == TETRIS_DOOR && !isTetrisSolved()) {
         Mix_PlayChannel(-1, correctSound, 0);
-        showMessage(renderer, "Tetris Challenge!");
-        if (runTetrisGame(renderer)) {
-            setTetrisSolved(true);
-            showMessage(renderer, "Tetris Solved!");
-        } else {
-            showMessage(renderer, "Score < 1000. Returning to Menu...");
-            ctx.nextState = MENU;
-            quit = true;
-        }
-    } else if (isTetrisSolved() && !isCircuitSolved() && SDL_HasIntersection(&click, &door2)  && player.x > 250 && player.x < 315   ) {
+        showMessage(stack, renderer, "Tetris Challenge!", [renderer, &stack, &ctx](bool) {
+            stack.push(createTetrisScene(renderer), [renderer, &stack, &ctx](bool won) {
+                if (won) {
+                    setTetrisSolved(true);
+                    showMessage(stack, renderer, "Tetris Solved!");
+                } else {
+                    showMessage(stack, renderer, "Score < 1000. Returning to Menu...",
+                                [&ctx](bool) { ctx.nextState = MENU; });
+                }
+            });
+        });
+    } else if (door == CIRCUIT_DOOR && isTetrisSolved() && !isCircuitSolved()) {
         Mix_PlayChannel(-1, correctSound, 0);
-        showMessage(renderer, "Circuit Challenge!");
-        runCircuitGame(renderer,ctx);
-        setCircuitSolved(true);
-    } else if (isCircuitSolved() && !isProjectionSolved() && SDL_HasIntersection(&click, &door3)  && player.x > 455 && player.x < 530    ) {
+        showMessage(stack, renderer, "Circuit Challenge!", [renderer, &stack, &ctx](bool) {
+            stack.push(createCircuitScene(renderer, ctx), [](bool) { setCircuitSolved(true); });
+        });
+    } else if (door == PROJECTION_DOOR && isCircuitSolved() && !isProjectionSolved()) {
         Mix_PlayChannel(-1, correctSound, 0);
-        showMessage(renderer, "Projection Challenge!");
-        runProjectionGame(renderer);
-        setProjectionSolved(true);
-    } else if (isProjectionSolved() && SDL_HasIntersection(&click, &door4) && player.x > 665 && player.x < 740   ) {
+        showMessage(stack, renderer, "Projection Challenge!", [renderer, &stack](bool) {
+            stack.push(createProjectionScene(renderer), [](bool) { setProjectionSolved(true); });
+        });
+    } else if (door == EXIT_DOOR && isProjectionSolved()) {
         Mix_PlayChannel(-1, correctSound, 0);
-        showMessage(renderer, "Floor 3 Unlocked!");
-        advanceToNextFloor();
-        quit = true;
+        showMessage(stack, renderer, "Floor 3 Unlocked!", [](bool) { advanceToNextFloor(); });
     }
 }
 
@@ -152,67 +181,90 @@ static void handleClick(int mx, int my, SDL_Renderer* renderer, bool& quit, Game
 
 static void render(SDL_Renderer* renderer) {
     SDL_RenderClear(renderer);
-    SDL_Rect src = camera;
-    SDL_Rect dst = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_RenderCopy(renderer, backgroundTexture, &src, &dst);
+    background.stream(camera);
+    background.draw(renderer, camera);
 
     SDL_Rect playerOnScreen = {player.x - camera.x, player.y - camera.y, player.w, player.h};
     SDL_RenderCopy(renderer, playerTexture, nullptr, &playerOnScreen);
 
     SDL_SetRenderDrawColor(renderer, 200, 0, 0, 255);
     SDL_RenderFillRect(renderer, &quitBtn);
-    TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 24);
+    TTF_Font* font = FontRegistry::instance().get("arial.ttf", 24);
     if (font) {
-        SDL_Color color = {255, 255, 255};
-        SDL_Rect r;
-        SDL_Texture* txt = renderText(renderer, font, "Quit", color, r);
-        r.x = quitBtn.x + 20;
-        r.y = quitBtn.y + 8;
-        SDL_RenderCopy(renderer, txt, nullptr, &r);
-        SDL_DestroyTexture(txt);
-        TTF_CloseFont(font);
+        SDL_Color color = {255, 255, 255, 255};
+        drawText(renderer, font, "Quit", color, quitBtn.x + 20, quitBtn.y + 8);
     }
-
-    SDL_RenderPresent(renderer);
 }
 
 static void cleanUp() {
-    if (correctSound) Mix_FreeChunk(correctSound);
-    if (moveSfx) Mix_FreeChunk(moveSfx);
-    SDL_DestroyTexture(backgroundTexture);
-    SDL_DestroyTexture(playerTexture);
-    backgroundTexture = nullptr;
-    playerTexture = nullptr;
+    background.close();
+    playerTexture.reset();
     correctSound = nullptr;
     moveSfx = nullptr;
 }
 
-void runFloor2(GameContext& ctx) {
-    SDL_Renderer* renderer = ctx.renderer;
-    player = {480, 700, 50, 50};
-
-    if (!loadMedia(renderer)) return;
+// ----------------------------------------------------
+// Floor2Scene: four doors, each unlocked by the challenge behind the one
+// before it. The floor stays resident underneath each challenge.
+// ----------------------------------------------------
+class Floor2Scene : public Scene {
+public:
+    explicit Floor2Scene(GameContext& ctx) : ctx(ctx) {}
+
+    void enter() override {
+        player = {480, 700, 50, 50};
+        if (!loadMedia(ctx.renderer)) ctx.nextState = MENU;
+        else updateCamera();
+    }
 
-    SDL_Event e;
-    bool quit = false;
+    void exit() override { cleanUp(); }
 
-    while (!quit) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                SDL_Quit();
-                exit(0);
-            }
-            handleInput(e);
-            if (e.type == SDL_MOUSEBUTTONDOWN) {
-                int mx, my;
-                SDL_GetMouseState(&mx, &my);
-                handleClick(mx, my, renderer, quit, ctx);
-            }
+    void handleEvent(const SDL_Event& e) override {
+        handleInput(e);
+        if (e.type == SDL_MOUSEBUTTONDOWN) {
+            int mx = e.button.x, my = e.button.y;
+            handleClick(mx, my, ctx.renderer, stack(), ctx);
         }
+    }
+
+    // Not in render(): clicks go through the camera, and --fast replays skip rendering
+    void update(double step) override { updateCamera(); }
+
+    void render(SDL_Renderer* renderer, float alpha) override {
+        ::render(renderer);
+    }
 
-        updateCamera();
-        render(renderer);
+    int redrawIntervalMs() const override {
+        return background.isStreaming() ? 0 : FrameScheduler::IDLE_WAKE_MS;
     }
 
-    cleanUp();
-}
\ No newline at end of file
+private:
+    GameContext& ctx;
+};
+
+std::unique_ptr<Scene> createFloor2Scene(GameContext& ctx) {
+    return std::make_unique<Floor2Scene>(ctx);
+}
+
+const AssetList& floor2Assets() {
+    static const AssetList assets = [] {
+        AssetList list = {
+            {
+                "assets/images/player.png",
+                "assets/images/tetris_background.png", "assets/images/circuit_background.png",
+                "assets/images/led.png", "assets/images/battery.png", "assets/images/resistor.png",
+                "assets/images/capacitor.png", "assets/images/diode.png", "assets/images/ammeter.png",
+                "assets/images/voltmeter.png"
+            },
+            {
+                "assets/audio/robot.mp3", "assets/audio/correct.mp3", "assets/audio/move.mp3",
+                "assets/audio/rotate.mp3", "assets/audio/line_clear.mp3", "assets/audio/pick.mp3",
+                "assets/audio/place.mp3", "assets/audio/success_circuit.mp3",
+                "assets/audio/fail_circuit.mp3", "assets/audio/error.mp3", "assets/audio/victory.mp3"
+            }
+        };
+        TiledBackground::appendTiles(list, BACKGROUND_TILES, BACKGROUND_IMAGE);
+        return list;
+    }();
+    return assets;
+}
@@ -1,8 +1,15 @@
 #ifndef FLOOR2_H
 #define FLOOR2_H
 
+#include <memory>
 #include "../../common/GameContext.h"
+#include "../../common/scene.h"
 
-void runFloor2(GameContext& ctx);  // Must match definition in .cpp
+struct AssetList;
+
+std::unique_ptr<Scene> createFloor2Scene(GameContext& ctx);
+
+// Images and sounds the floor and its minigames use, for AssetLoader
+const AssetList& floor2Assets();
 
 #endif
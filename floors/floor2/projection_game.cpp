@@ -8,6 +8,12 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/scene.h"
 
 // Constants
 static constexpr int WIDTH         = 800;
@@ -67,19 +73,6 @@ static void drawPoint(SDL_Renderer* R, const Vec2& v, SDL_Color c, int rad=6) {
           SDL_RenderDrawPoint(R, sx+dx, sy+dy);
 }
 
-// Render text at (x,y)
-static void renderText(SDL_Renderer* R, TTF_Font* f,
-                       const std::string& txt, SDL_Color c, int x, int y)
-{
-    SDL_Surface* surf = TTF_RenderUTF8_Blended(f, txt.c_str(), c);
-    if(!surf) return;
-    SDL_Texture* tx = SDL_CreateTextureFromSurface(R, surf);
-    SDL_Rect dst{ x,y, surf->w, surf->h };
-    SDL_FreeSurface(surf);
-    SDL_RenderCopy(R, tx, nullptr, &dst);
-    SDL_DestroyTexture(tx);
-}
-
 // Strict parse "int,int"
 static bool parseVec2(const std::string& s, Vec2& out) {
     std::string t; t.reserve(s.size());
@@ -110,107 +103,106 @@ static Vec2 project(const Vec2& y, const Vec2& u) {
     return u*k;
 }
 
-void runProjectionGame(SDL_Renderer* renderer) {
-    TTF_Font* font       = TTF_OpenFont("assets/fonts/OpenSans-Bold.ttf", 20);
-    Mix_Music* bgm       = Mix_LoadMUS("assets/audio/projection_background.mp3");
-    Mix_Chunk* clickSfx  = Mix_LoadWAV("assets/audio/error.mp3");
-    Mix_Chunk* winSfx    = Mix_LoadWAV("assets/audio/victory.mp3");
-    SDL_Texture* bgTex   = IMG_LoadTexture(renderer, "assets/images/projection_3d_bg.png");
-
-    if (bgm) Mix_PlayMusic(bgm, -1);
-
-start_game:
-    Vec2 u1 = {1, 0}, u2 = {0, 1};
-    Vec2 u1_vis = u1 * double(COLS - 1), u2_vis = u2 * double(ROWS - 1);
-    Vec2 y = {6, 7};
-
-    bool running = true;
-    bool showProj = true;
-    bool inputMode = false;
-    bool winFlag = false;
-    int stage = 0;
-    std::string userInput, inputErr;
-    Vec2 userY1, userY2;
+// ----------------------------------------------------
+// ProjectionScene: move y with the arrow keys, then type its projections
+// onto u1 and u2. A wrong answer or the time limit restarts the round;
+// the scene finishes once a round is won.
+// ----------------------------------------------------
+class ProjectionScene : public Scene {
+public:
+    explicit ProjectionScene(SDL_Renderer* renderer) : renderer(renderer) {}
+
+    void enter() override {
+        font     = FontRegistry::instance().get("OpenSans-Bold.ttf", 20);
+        bgm      = Mix_LoadMUS("assets/audio/projection_background.mp3");
+        clickSfx = SoundBank::instance().get("assets/audio/error.mp3");
+        winSfx   = SoundBank::instance().get("assets/audio/victory.mp3");
+        bgTex    = TextureCache::instance().acquire(renderer, "assets/images/projection_3d_bg.png");
+
+        if (bgm) Mix_PlayMusic(bgm, -1);
+        startGame();
+    }
 
-    Uint32 startTime = SDL_GetTicks();
-    SDL_StartTextInput();
+    void exit() override {
+        SDL_StopTextInput();
+        if (bgm) { Mix_HaltMusic(); Mix_FreeMusic(bgm); bgm = nullptr; }
+        Mix_HaltMusic();
+    }
 
-    while (running) {
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                // Block quitting unless won
-                if (!winFlag) {
-                    if (clickSfx) Mix_PlayChannel(-1, clickSfx, 0);
-                    continue;
-                } else {
-                    running = false;
+    void handleEvent(const SDL_Event& e) override {
+        if (holdTimer > 0.0) return;
+
+        if (!inputMode && stage < 3 && e.type == SDL_KEYDOWN) {
+            switch (e.key.keysym.sym) {
+                case SDLK_LEFT:  if (y.x > 0) y.x--; break;
+                case SDLK_RIGHT: if (y.x < COLS - 1) y.x++; break;
+                case SDLK_DOWN:  if (y.y > 0) y.y--; break;
+                case SDLK_UP:    if (y.y < ROWS - 1) y.y++; break;
+                case SDLK_SPACE: showProj = !showProj; break;
+                case SDLK_RETURN:
+                    inputMode = true; stage = 1;
+                    userInput.clear(); inputErr.clear();
                     break;
-                }
             }
-
-            if (!inputMode && stage < 3 && e.type == SDL_KEYDOWN) {
-                switch (e.key.keysym.sym) {
-                    case SDLK_LEFT:  if (y.x > 0) y.x--; break;
-                    case SDLK_RIGHT: if (y.x < COLS - 1) y.x++; break;
-                    case SDLK_DOWN:  if (y.y > 0) y.y--; break;
-                    case SDLK_UP:    if (y.y < ROWS - 1) y.y++; break;
-                    case SDLK_SPACE: showProj = !showProj; break;
-                    case SDLK_RETURN:
-                        inputMode = true; stage = 1;
-                        userInput.clear(); inputErr.clear();
-                        break;
-                }
-            } else if (inputMode && e.type == SDL_TEXTINPUT) {
-                userInput += e.text.text;
-            } else if (inputMode && e.type == SDL_KEYDOWN) {
-                if (e.key.keysym.sym == SDLK_BACKSPACE && !userInput.empty())
-                    userInput.pop_back();
-                else if (e.key.keysym.sym == SDLK_RETURN) {
-                    Vec2 parsed;
-                    if (parseVec2(userInput, parsed)) {
-                        inputErr.clear();
-                        if (stage == 1) {
-                            userY1 = parsed;
-                            stage = 2;
-                            userInput.clear();
-                        } else if (stage == 2) {
-                            userY2 = parsed;
-                            stage = 3;
-                            inputMode = false;
-
-                            Vec2 c1 = project(y, u1), c2 = project(y, u2);
-                            winFlag = closeEnough(userY1, c1) && closeEnough(userY2, c2);
-
-                            if (winFlag) {
-                                if (winSfx) Mix_PlayChannel(-1, winSfx, 0);
-                            } else {
-                                if (clickSfx) Mix_PlayChannel(-1, clickSfx, 0);
-                            }
+        } else if (inputMode && e.type == SDL_TEXTINPUT) {
+            userInput += e.text.text;
+        } else if (inputMode && e.type == SDL_KEYDOWN) {
+            if (e.key.keysym.sym == SDLK_BACKSPACE && !userInput.empty())
+                userInput.pop_back();
+            else if (e.key.keysym.sym == SDLK_RETURN) {
+                Vec2 parsed;
+                if (parseVec2(userInput, parsed)) {
+                    inputErr.clear();
+                    if (stage == 1) {
+                        userY1 = parsed;
+                        stage = 2;
+                        userInput.clear();
+                    } else if (stage == 2) {
+                        userY2 = parsed;
+                        stage = 3;
+                        inputMode = false;
+
+                        Vec2 c1 = project(y, u1), c2 = project(y, u2);
+                        winFlag = closeEnough(userY1, c1) && closeEnough(userY2, c2);
+
+                        if (winFlag) {
+                            if (winSfx) Mix_PlayChannel(-1, winSfx, 0);
+                        } else {
+                            if (clickSfx) Mix_PlayChannel(-1, clickSfx, 0);
                         }
-                    } else {
-                        inputErr = "Invalid format, use x,y";
-                        if (clickSfx) Mix_PlayChannel(-1, clickSfx, 0);
+                        holdTimer = 1.5;  // show the result, then finish or restart
                     }
-                } else if (e.key.keysym.sym == SDLK_ESCAPE) {
-                    inputMode = false; stage = 0;
-                    userInput.clear(); inputErr.clear();
+                } else {
+                    inputErr = "Invalid format, use x,y";
+                    if (clickSfx) Mix_PlayChannel(-1, clickSfx, 0);
                 }
+            } else if (e.key.keysym.sym == SDLK_ESCAPE) {
+                inputMode = false; stage = 0;
+                userInput.clear(); inputErr.clear();
             }
         }
+    }
+
+    void update(double dt) override {
+        if (holdTimer > 0.0) {
+            holdTimer -= dt;
+            if (holdTimer > 0.0) return;
+            if (winFlag) finish(true);
+            else startGame();  // restart after a wrong answer or a timeout
+            return;
+        }
 
         // --- timer ---
-        Uint32 now = SDL_GetTicks();
-        if (!winFlag && now - startTime >= TIME_LIMIT) {
+        if (!winFlag && FrameScheduler::gameTicks() - startTime >= TIME_LIMIT) {
             if (clickSfx) Mix_PlayChannel(-1, clickSfx, 0);
-            SDL_Delay(1500);
-            goto start_game;  // Restart game on timeout
+            holdTimer = 1.5;
         }
+    }
 
+    void render(SDL_Renderer* renderer, float alpha) override {
         // Projections
         Vec2 p1 = project(y, u1), p2 = project(y, u2);
 
-        // --- render ---
         if (bgTex) {
             SDL_RenderCopy(renderer, bgTex, nullptr, nullptr);
         } else {
@@ -230,18 +222,18 @@ start_game:
         // Axes
         drawArrow(renderer, {0, 0}, {COLS - 1, 0}, {240, 240, 255, 255}, 6);
         drawArrow(renderer, {0, 0}, {0, ROWS - 1}, {240, 240, 255, 255}, 6);
-        renderText(renderer, font, "x", {220, 220, 255, 255},
+        drawText(renderer, font, "x", {220, 220, 255, 255},
                    GRID_ORIGIN_X + (COLS - 1) * CELL + 10, GRID_ORIGIN_Y + 5);
-        renderText(renderer, font, "y", {220, 220, 255, 255},
+        drawText(renderer, font, "y", {220, 220, 255, 255},
                    GRID_ORIGIN_X - 20, GRID_ORIGIN_Y - ROWS * CELL - 5);
 
         // Basis vectors
         drawArrow(renderer, {0, 0}, u1_vis, {255, 120, 40, 255}, 8);
         drawArrow(renderer, {0, 0}, u2_vis, {60, 200, 255, 255}, 8);
-        renderText(renderer, font, "u1", {255, 120, 40, 255},
+        drawText(renderer, font, "u1", {255, 120, 40, 255},
                    GRID_ORIGIN_X + int(u1_vis.x * CELL) + 5,
                    GRID_ORIGIN_Y - int(u1_vis.y * CELL) - 25);
-        renderText(renderer, font, "u2", {60, 200, 255, 255},
+        drawText(renderer, font, "u2", {60, 200, 255, 255},
                    GRID_ORIGIN_X + int(u2_vis.x * CELL) + 5,
                    GRID_ORIGIN_Y - int(u2_vis.y * CELL) - 25);
 
@@ -254,10 +246,10 @@ start_game:
         }
 
         // Instructions
-        renderText(renderer, font,
+        drawText(renderer, font,
                    (showProj ? "SPACE: hide projections" : "SPACE: show projections"),
                    {200, 200, 200, 180}, 10, 10);
-        renderText(renderer, font, "ENTER: input projections",
+        drawText(renderer, font, "ENTER: input projections",
                    {200, 200, 200, 180}, 10, 30);
 
         // Input overlay
@@ -265,13 +257,13 @@ start_game:
             SDL_Rect ov{100, 220, WIDTH - 200, 140};
             SDL_SetRenderDrawColor(renderer, 30, 30, 50, 210);
             SDL_RenderFillRect(renderer, &ov);
-            renderText(renderer, font,
+            drawText(renderer, font,
                        stage == 1 ? "Enter y1 (x,y):" : "Enter y2 (x,y):",
                        {255, 255, 255, 255}, 120, 250);
-            renderText(renderer, font, userInput + "|",
+            drawText(renderer, font, userInput + "|",
                        {255, 255, 200, 255}, 120, 290);
             if (!inputErr.empty()) {
-                renderText(renderer, font, inputErr,
+                drawText(renderer, font, inputErr,
                            {255, 80, 80, 255}, 120, 330);
             }
         }
@@ -282,38 +274,49 @@ start_game:
             SDL_SetRenderDrawColor(renderer,
                 winFlag ? 30 : 60, winFlag ? 120 : 30, winFlag ? 30 : 60, 200);
             SDL_RenderFillRect(renderer, &ov);
-            renderText(renderer, font,
+            drawText(renderer, font,
                 winFlag ? "Correct!" : "Wrong!",
                 winFlag ? SDL_Color{50, 255, 100, 255} : SDL_Color{255, 80, 80, 255},
                 WIDTH / 2 - 50, HEIGHT / 2);
-            SDL_RenderPresent(renderer);
-            SDL_Delay(1500);
-
-            if (!winFlag) goto start_game;  // restart if failed
-            else break;                     // exit if passed
         }
-
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
     }
 
-    SDL_StopTextInput();
-    if (bgTex) SDL_DestroyTexture(bgTex);
-    if (bgm) { Mix_HaltMusic(); Mix_FreeMusic(bgm); }
-    if (clickSfx) Mix_FreeChunk(clickSfx);
-    if (winSfx) Mix_FreeChunk(winSfx);
-    if (font) TTF_CloseFont(font);
-    Mix_HaltMusic();
-}
-
-
-
-
-
-
-
+private:
+    void startGame() {
+        y = {6, 7};
+        showProj = true;
+        inputMode = false;
+        winFlag = false;
+        stage = 0;
+        userInput.clear();
+        inputErr.clear();
+        holdTimer = 0.0;
+        startTime = FrameScheduler::gameTicks();
+        SDL_StartTextInput();
+    }
 
+    SDL_Renderer* renderer;
+    TTF_Font* font = nullptr;
+    Mix_Music* bgm = nullptr;
+    Mix_Chunk* clickSfx = nullptr;
+    Mix_Chunk* winSfx = nullptr;
+    TextureHandle bgTex;
 
+    const Vec2 u1 = {1, 0}, u2 = {0, 1};
+    const Vec2 u1_vis = u1 * double(COLS - 1), u2_vis = u2 * double(ROWS - 1);
+    Vec2 y = {6, 7};
 
+    bool showProj = true;
+    bool inputMode = false;
+    bool winFlag = false;
+    int stage = 0;
+    std::string userInput, inputErr;
+    Vec2 userY1, userY2;
 
+    Uint32 startTime = 0;
+    double holdTimer = 0.0;  // result/timeout pause before the next round
+};
 
+std::unique_ptr<Scene> createProjectionScene(SDL_Renderer* renderer) {
+    return std::make_unique<ProjectionScene>(renderer);
+}
@@ -2,7 +2,9 @@
 #define PROJECTION_GAME_H
 
 #include <SDL2/SDL.h>
+#include <memory>
+#include "../../common/scene.h"
 
-void runProjectionGame(SDL_Renderer* renderer);
+std::unique_ptr<Scene> createProjectionScene(SDL_Renderer* renderer);
 
 #endif
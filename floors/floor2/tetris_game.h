@@ -2,7 +2,10 @@
 #define TETRIS_GAME_H
 
 #include <SDL2/SDL.h>
+#include <memory>
+#include "../../common/scene.h"
 
-bool runTetrisGame(SDL_Renderer* parentRenderer);
+// Finishes with true once the score reaches 500
+std::unique_ptr<Scene> createTetrisScene(SDL_Renderer* parentRenderer);
 
 #endif // TETRIS_GAME_H
\ No newline at end of file
@@ -3,8 +3,16 @@
 #include "monster_game.h"
 #include "../../common/game_state.h"
 #include "../../common/utils.h"
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/asset_loader.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/spatial_grid.h"
+#include "../../common/tiled_background.h"
 #include "../../common/GameContext.h"
-#include "../../UI/leaderboard.h"
+#include "../../UI/message_scene.h"
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_ttf.h>
@@ -18,34 +26,54 @@ static const int SCREEN_HEIGHT = 600;
 static int WORLD_WIDTH = 1600;
 static int WORLD_HEIGHT = 1200;
 
-static SDL_Texture *backgroundTexture = nullptr;
-static SDL_Texture *playerTexture = nullptr;
+// Background tiles, or the whole image if `make tiles` has not run
+static const char* BACKGROUND_TILES = "assets/tiles/floor3";
+static const char* BACKGROUND_IMAGE = "assets/images/floor3.png";
+static TiledBackground background;
+static TextureHandle playerTexture;
 static Mix_Chunk *correctSound = nullptr;
 
 static SDL_Rect camera = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
 
-static SDL_Rect door1 = {70, 75, 105, 162};  // Empty
-static SDL_Rect door2 = {255, 75, 105, 162}; // Space Shooter
-static SDL_Rect door3 = {445, 75, 105, 162}; // Empty
-static SDL_Rect door4 = {665, 75, 105, 162}; // Monster Game
+// Doors here can be clicked from anywhere and do not block movement
+enum : Uint32 { DOOR = 1 };
+enum { EMPTY_DOOR_1, SHOOTER_DOOR, EMPTY_DOOR_2, MONSTER_DOOR };
+
+static const SDL_Rect doors[] = {
+    {70, 75, 105, 162},   // EMPTY_DOOR_1
+    {255, 75, 105, 162},  // SHOOTER_DOOR
+    {445, 75, 105, 162},  // EMPTY_DOOR_2
+    {665, 75, 105, 162},  // MONSTER_DOOR
+};
 static SDL_Rect quitBtn = {20, 20, 100, 40}; // Quit button on screen
 
+static SpatialGrid grid;
+
+static void buildGrid()
+{
+    grid.clear();
+    for (int i = 0; i < int(sizeof(doors) / sizeof(doors[0])); ++i)
+        grid.insert(doors[i], DOOR, i);
+}
+
 static bool shooterWon = false;
 
 Mix_Chunk* moveSound = nullptr;
 
 static bool loadMedia(SDL_Renderer *renderer) {
-    backgroundTexture = IMG_LoadTexture(renderer, "assets/images/floor3.png");
-    playerTexture = IMG_LoadTexture(renderer, "assets/images/player.png");
-    correctSound = Mix_LoadWAV("assets/audio/correct.wav");
-    moveSound = Mix_LoadWAV("assets/audio/robot.mp3");  // Load the move sound
+    bool haveBackground = background.open(renderer, BACKGROUND_TILES, BACKGROUND_IMAGE);
+    playerTexture = TextureCache::instance().acquire(renderer, "assets/images/player.png");
+    correctSound = SoundBank::instance().get("assets/audio/correct.wav");
+    moveSound = SoundBank::instance().get("assets/audio/robot.mp3");  // Load the move sound
 
-    if (!backgroundTexture || !playerTexture || !correctSound || !moveSound) {
+    if (!haveBackground || !playerTexture || !correctSound || !moveSound) {
         std::cerr << "Media loading failed: " << IMG_GetError() << " / " << Mix_GetError() << std::endl;
         return false;
     }
 
-    SDL_QueryTexture(backgroundTexture, nullptr, nullptr, &WORLD_WIDTH, &WORLD_HEIGHT);
+    WORLD_WIDTH = background.width();
+    WORLD_HEIGHT = background.height();
+    buildGrid();
     return true;
 }
 
@@ -61,7 +89,7 @@ static bool canMove(int dx, int dy)
             temp.y + temp.h <= WORLD_HEIGHT);
 }
 
-static void handleInput(SDL_Event &e) {
+static void handleInput(const SDL_Event &e) {
     if (e.type == SDL_KEYDOWN) {
         int dx = 0, dy = 0;
         switch (e.key.keysym.sym) {
@@ -100,79 +128,68 @@ static void updateCamera()
     camera.y = std::clamp(camera.y, 0, WORLD_HEIGHT - camera.h);
 }
 
-static void showMessage(SDL_Renderer *renderer, const std::string &text)
+// Full-screen notice, then `then` once it has been shown
+static void showMessage(SceneStack &stack, SDL_Renderer *renderer, const std::string &text,
+                        SceneCallback then = nullptr)
 {
-    TTF_Font *font = TTF_OpenFont("assets/fonts/arial.ttf", 36);
-    if (!font)
-        return;
-    SDL_Color color = {255, 255, 255};
-    SDL_Surface *surface = TTF_RenderText_Solid(font, text.c_str(), color);
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect rect = {250, 250, 300, 100};
-
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, texture, nullptr, &rect);
-    SDL_RenderPresent(renderer);
-
-    SDL_Delay(1500);
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
-    TTF_CloseFont(font);
+    stack.push(std::make_unique<MessageScene>(renderer, text), std::move(then));
 }
 
-static void handleClick(int mx, int my, SDL_Renderer *renderer, bool &quit, GameContext &ctx, bool &monsterPlayed)
+static void handleClick(int mx, int my, SDL_Renderer *renderer, SceneStack &stack, GameContext &ctx)
 {
     if (mx >= quitBtn.x && mx <= quitBtn.x + quitBtn.w &&
         my >= quitBtn.y && my <= quitBtn.y + quitBtn.h)
     {
         ctx.nextState = MENU;
-        quit = true;
         return;
     }
 
-    SDL_Rect click = {mx + camera.x, my + camera.y, 1, 1};
+    int hit = grid.firstAt(mx + camera.x, my + camera.y, DOOR);
+    if (hit < 0)
+        return;
+    int door = grid.value(hit);
 
-    if (SDL_HasIntersection(&click, &door1))
+    if (door == EMPTY_DOOR_1)
     {
-        showMessage(renderer, "There is nothing.");
+        showMessage(stack, renderer, "There is nothing.");
         return;
     }
 
-    if (SDL_HasIntersection(&click, &door2))
+    if (door == SHOOTER_DOOR)
     {
         Mix_PlayChannel(-1, correctSound, 0);
-        showMessage(renderer, "KILL THE ENEMIES \n FACE THE BOSS");
-        shooterWon = runSpaceShooterGame(renderer);
+        showMessage(stack, renderer, "KILL THE ENEMIES \n FACE THE BOSS", [renderer, &stack](bool) {
+            stack.push(createSpaceShooterScene(renderer), [](bool won) { shooterWon = won; });
+        });
         return;
     }
 
-    if (SDL_HasIntersection(&click, &door3))
+    if (door == EMPTY_DOOR_2)
     {
-        showMessage(renderer, "There is nothing.");
+        showMessage(stack, renderer, "There is nothing.");
         return;
     }
 
-    if (SDL_HasIntersection(&click, &door4))
+    if (door == MONSTER_DOOR)
     {
         if (!shooterWon)
         {
-            showMessage(renderer, "LOCKED. KILLED ALL ENEMIES ?");
+            showMessage(stack, renderer, "LOCKED. KILLED ALL ENEMIES ?");
             return;
         }
         Mix_PlayChannel(-1, correctSound, 0);
-        showMessage(renderer, "BEAT THE FINAL BOSS!");
-        runMonsterGame(renderer,ctx);
-        monsterPlayed = true;
-        quit = true;
+        showMessage(stack, renderer, "BEAT THE FINAL BOSS!", [renderer, &stack, &ctx](bool) {
+            // Win or lose, the run ends here and goes back to the menu
+            stack.push(createMonsterScene(renderer, ctx), [&ctx](bool) { ctx.nextState = MENU; });
+        });
     }
 }
 
 static void render(SDL_Renderer *renderer)
 {
     SDL_RenderClear(renderer);
-    SDL_Rect src = camera;
-    SDL_Rect dst = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_RenderCopy(renderer, backgroundTexture, &src, &dst);
+    background.stream(camera);
+    background.draw(renderer, camera);
 
     SDL_Rect p = {player.x - camera.x, player.y - camera.y, player.w, player.h};
     SDL_RenderCopy(renderer, playerTexture, nullptr, &p);
@@ -180,93 +197,91 @@ static void render(SDL_Renderer *renderer)
     SDL_SetRenderDrawColor(renderer, 200, 0, 0, 255);
     SDL_RenderFillRect(renderer, &quitBtn);
 
-    TTF_Font *font = TTF_OpenFont("assets/fonts/arial.ttf", 24);
+    TTF_Font *font = FontRegistry::instance().get("arial.ttf", 24);
     if (font)
     {
-        SDL_Color color = {255, 255, 255};
-        SDL_Rect r;
-        SDL_Texture *txt = renderText(renderer, font, "Quit", color, r);
-        r.x = quitBtn.x + 20;
-        r.y = quitBtn.y + 8;
-        SDL_RenderCopy(renderer, txt, nullptr, &r);
-        SDL_DestroyTexture(txt);
-        TTF_CloseFont(font);
+        SDL_Color color = {255, 255, 255, 255};
+        drawText(renderer, font, "Quit", color, quitBtn.x + 20, quitBtn.y + 8);
     }
-
-    SDL_RenderPresent(renderer);
 }
 
 static void cleanUp() {
-    Mix_FreeChunk(correctSound);
-    Mix_FreeChunk(moveSound);  // Free the move sound
-    SDL_DestroyTexture(backgroundTexture);
-    SDL_DestroyTexture(playerTexture);
+    background.close();
+    playerTexture.reset();
     correctSound = nullptr;
     moveSound = nullptr;  // Set the move sound to nullptr
-    backgroundTexture = nullptr;
-    playerTexture = nullptr;
 }
 
-void runFloor3(GameContext &ctx)
+// ----------------------------------------------------
+// Floor3Scene: the shooter behind door 2 unlocks the boss behind door 4.
+// The floor stays resident underneath both.
+// ----------------------------------------------------
+class Floor3Scene : public Scene
 {
-    SDL_Renderer *renderer = ctx.renderer;
-    player = {470, 665, 85, 80};
+public:
+    explicit Floor3Scene(GameContext &ctx) : ctx(ctx) {}
 
-    if (!loadMedia(renderer))
-        return;
+    void enter() override
+    {
+        player = {470, 665, 85, 80};
+        if (!loadMedia(ctx.renderer))
+            ctx.nextState = MENU;
+        else
+            updateCamera();
+    }
 
-    bool quit = false;
-    bool monsterPlayed = false;
-    SDL_Event e;
+    void exit() override { cleanUp(); }
 
-    while (!quit)
+    void handleEvent(const SDL_Event &e) override
     {
-        while (SDL_PollEvent(&e))
-        {
-            if (e.type == SDL_QUIT)
-                quit = true;
+        handleInput(e);
 
-            handleInput(e);
-
-            if (e.type == SDL_MOUSEBUTTONDOWN)
-            {
-                int mx, my;
-                SDL_GetMouseState(&mx, &my);
-                handleClick(mx, my, renderer, quit, ctx, monsterPlayed);
-            }
+        if (e.type == SDL_MOUSEBUTTONDOWN)
+        {
+            int mx = e.button.x, my = e.button.y;
+            handleClick(mx, my, ctx.renderer, stack(), ctx);
         }
+    }
 
+    // Kept out of render() so the camera also moves in a --fast replay
+    void update(double step) override
+    {
         updateCamera();
-        render(renderer);
     }
 
-    cleanUp();
-
-    // Leaderboard update after Monster Game win
-       // Leaderboard update after Monster Game win
-   /* if (shooterWon && monsterPlayed)
+    void render(SDL_Renderer *renderer, float alpha) override
     {
-        TTF_Font *font = TTF_OpenFont("assets/fonts/arial.ttf", 36);
-        if (font)
-        {
-            Leaderboard leaderboard(font);
-            leaderboard.loadFromFile("leaderboard.txt");
-
-            using namespace std::chrono;
-            float timeSpent = duration_cast<duration<float>>(steady_clock::now() - ctx.startTime).count();
+        ::render(renderer);
+    }
 
-            leaderboard.players.emplace_back(ctx.playerName, timeSpent);
+    int redrawIntervalMs() const override {
+        return background.isStreaming() ? 0 : FrameScheduler::IDLE_WAKE_MS;
+    }
 
-            std::sort(leaderboard.players.begin(), leaderboard.players.end());
-            if (leaderboard.players.size() > 5)
-                leaderboard.players.resize(5);
+private:
+    GameContext &ctx;
+};
 
-            leaderboard.saveToFile("leaderboard.txt");
-            TTF_CloseFont(font);
-        }
+std::unique_ptr<Scene> createFloor3Scene(GameContext &ctx)
+{
+    return std::make_unique<Floor3Scene>(ctx);
+}
 
-        // ✅ Automatically return to menu after saving leaderboard
-        ctx.nextState = MENU;
-    }*/
-   if(monsterPlayed) ctx.nextState = MENU;
-}
\ No newline at end of file
+const AssetList& floor3Assets() {
+    static const AssetList assets = [] {
+        AssetList list = {
+            {
+                "assets/images/player.png",
+                "assets/images/space_background.png", "assets/images/monster_background.png",
+                "assets/atlas/shooter.png", "assets/atlas/monster.png"
+            },
+            {
+                "assets/audio/robot.mp3", "assets/audio/correct.wav", "assets/audio/space_shoot.mp3",
+                "assets/audio/shoot_player.mp3", "assets/audio/shoot_enemy.mp3"
+            }
+        };
+        TiledBackground::appendTiles(list, BACKGROUND_TILES, BACKGROUND_IMAGE);
+        return list;
+    }();
+    return assets;
+}
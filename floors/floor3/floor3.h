@@ -1,9 +1,16 @@
 #ifndef FLOOR3_H
 #define FLOOR3_H
 
+#include <memory>
 #include "../../common/GameContext.h"
+#include "../../common/scene.h"
+
+struct AssetList;
 
 // Entry point for Floor 3 logic
-void runFloor3(GameContext& ctx);
+std::unique_ptr<Scene> createFloor3Scene(GameContext& ctx);
+
+// Images and sounds the floor and its minigames use, for AssetLoader
+const AssetList& floor3Assets();
 
 #endif // FLOOR3_H
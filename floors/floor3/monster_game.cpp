@@ -4,7 +4,17 @@
 #include <SDL2/SDL_ttf.h>
 #include "../../common/GameContext.h"
 #include "../../GameManager.h"
-#include "../../UI/leaderboard.h"
+#include "../../common/run_writer.h"
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/input_state.h"
+#include "../../common/rng.h"
+#include "../../common/primitive_batch.h"
+#include "../../common/sprite_atlas.h"
+#include "../../common/scene.h"
 #include <vector>
 #include <cmath>
 #include <cstdlib>
@@ -14,6 +24,16 @@
 const int SCREEN_W = 800;
 const int SCREEN_H = 600;
 const int GAME_OVER_DISPLAY_TIME = 2000;
+const int MAX_BULLETS = 256;  // per side; far more than a fight puts on screen
+
+// Sprite ids in the monster atlas, in the order loadAtlas() lists them
+enum MonsterSprite
+{
+    HERO_SPRITE,
+    MONSTER_SPRITE,
+    PLAYER_BULLET_SPRITE,
+    MONSTER_BULLET_SPRITE
+};
 
 struct Vec2
 {
@@ -24,15 +44,29 @@ struct Entity
     Vec2 pos;
     int health;
 };
-struct Bullet
+// One side's bullets as structure of arrays. Live bullets are packed at
+// the front and a removed one is replaced by the last, so every loop runs
+// over live bullets only and the pool never allocates.
+struct BulletPool
 {
-    Vec2 pos, vel;
-    bool active;
+    float x[MAX_BULLETS], y[MAX_BULLETS];
+    float vx[MAX_BULLETS], vy[MAX_BULLETS];
+    int count = 0;
+
+    void clear() { count = 0; }
+    void remove(int i)
+    {
+        --count;
+        x[i] = x[count];
+        y[i] = y[count];
+        vx[i] = vx[count];
+        vy[i] = vy[count];
+    }
 };
 
 static Entity player = {{121, 0}, 100};
 static Entity monster = {{569, 0}, 100};
-static std::vector<Bullet> playerBullets, monsterBullets;
+static BulletPool playerBullets, monsterBullets;
 static float monsterTimer = 0, monsterInterval = 2.0f;
 static float monsterMoveTimer = 0, monsterMoveInterval = 1.0f;
 static bool gameOver = false;
@@ -45,31 +79,40 @@ float clamp(float v, float lo, float hi)
     return std::max(lo, std::min(v, hi));
 }
 
-void DrawBar(SDL_Renderer *R, Vec2 p, int health, SDL_Color col)
+void DrawBar(PrimitiveBatch &batch, Vec2 p, int health, SDL_Color col)
 {
     SDL_Rect bg = {int(p.x), int(p.y), 100, 10};
-    SDL_SetRenderDrawColor(R, 100, 100, 100, 255);
-    SDL_RenderFillRect(R, &bg);
+    batch.fillRect(bg, {100, 100, 100, 255});
     SDL_Rect fg = {int(p.x), int(p.y), health, 10};
-    SDL_SetRenderDrawColor(R, col.r, col.g, col.b, col.a);
-    SDL_RenderFillRect(R, &fg);
+    batch.fillRect(fg, col);
 }
 
-void Shoot(std::vector<Bullet> &B, Vec2 pos, Vec2 vel)
+void Shoot(BulletPool &B, Vec2 pos, Vec2 vel)
 {
-    B.push_back({pos, vel, true});
+    if (B.count == MAX_BULLETS)
+        return;
+    int i = B.count++;
+    B.x[i] = pos.x;
+    B.y[i] = pos.y;
+    B.vx[i] = vel.x;
+    B.vy[i] = vel.y;
 }
 
-void UpdateBullets(std::vector<Bullet> &B, float dt)
+void UpdateBullets(BulletPool &B, float dt)
 {
-    for (auto &b : B)
-        if (b.active)
-        {
-            b.pos.x += b.vel.x * dt;
-            b.pos.y += b.vel.y * dt;
-            if (b.pos.x < 0 || b.pos.x > SCREEN_W || b.pos.y < 0 || b.pos.y > SCREEN_H)
-                b.active = false;
-        }
+    for (int i = 0; i < B.count; ++i)
+    {
+        B.x[i] += B.vx[i] * dt;
+        B.y[i] += B.vy[i] * dt;
+    }
+    // A removed bullet's slot takes the last one, which is checked next
+    for (int i = 0; i < B.count;)
+    {
+        if (B.x[i] < 0 || B.x[i] > SCREEN_W || B.y[i] < 0 || B.y[i] > SCREEN_H)
+            B.remove(i);
+        else
+            ++i;
+    }
 }
 
 bool CircleRect(Vec2 c, float r, SDL_Rect R)
@@ -81,235 +124,242 @@ bool CircleRect(Vec2 c, float r, SDL_Rect R)
     return (dx * dx + dy * dy) < r * r;
 }
 
-void runMonsterGame(SDL_Renderer *ren, GameContext &ctx)
+// Removes the bullets that hit R and returns how many did
+int HitBullets(BulletPool &B, SDL_Rect R)
 {
-    SDL_Texture *texBG = IMG_LoadTexture(ren, "assets/images/monster_background.png");
-    SDL_Texture *texHero = IMG_LoadTexture(ren, "assets/images/hero.png");
-    SDL_Texture *texEnem = IMG_LoadTexture(ren, "assets/images/enemy.png");
-    SDL_Texture *texPB = IMG_LoadTexture(ren, "assets/images/bullet_player.png");
-    SDL_Texture *texEB = IMG_LoadTexture(ren, "assets/images/bullet_enemy.png");
-
-    Mix_Music *bgm = Mix_LoadMUS("assets/audio/starwars.wav");
-    Mix_Chunk *sfxShootP = Mix_LoadWAV("assets/audio/shoot_player.mp3");
-    Mix_Chunk *sfxShootE = Mix_LoadWAV("assets/audio/shoot_enemy.mp3");
-
-    TTF_Font *font = TTF_OpenFont("assets/fonts/CALIBRIL.TTF", 48);
-    if (!texBG || !texHero || !texEnem || !texPB || !texEB || !bgm || !sfxShootP || !sfxShootE || !font)
+    int hits = 0;
+    for (int i = 0; i < B.count;)
     {
-        SDL_Log("Asset load error: %s", SDL_GetError());
-        return;
+        if (CircleRect({B.x[i], B.y[i]}, 5, R))
+        {
+            B.remove(i);
+            ++hits;
+        }
+        else
+            ++i;
     }
+    return hits;
+}
 
-    Mix_PlayMusic(bgm, -1);
+// Every escape goes into the run log after the boss is beaten. The write
+// happens on RunWriter's thread; the menu shows the rank once it lands.
+static void recordWin(GameContext &ctx)
+{
+    using namespace std::chrono;
+    float timeSpent = duration_cast<duration<float>>(steady_clock::now() - ctx.startTime).count();
 
-    float heroScale = (100.0f / 64.0f) * 2.5f;
-    float enemScale = (100.0f / 64.0f) * 2.5f;
+    // Divide by 100 to convert to seconds
+    timeSpent /= 100.0f;
 
-    player = {{121, 400}, 100};
-    monster = {{569, SCREEN_H - 100 - 64 * enemScale}, 100};
-    playerBullets.clear();
-    monsterBullets.clear();
-    monsterTimer = monsterMoveTimer = 0;
-    gameOver = paused = false;
+    ctx.lastRank = 0;
+    RunWriter::instance().submit(ctx.playerName, timeSpent, [&ctx](size_t rank) { ctx.lastRank = rank; });
+}
 
-    bool running = true;
-    Uint32 last = SDL_GetTicks();
+// ----------------------------------------------------
+// MonsterScene: the final boss fight. Finishes with true if the monster
+// dies, two seconds after the result is shown.
+// ----------------------------------------------------
+class MonsterScene : public Scene
+{
+public:
+    MonsterScene(SDL_Renderer *ren, GameContext &ctx) : ren(ren), ctx(ctx), batch(ren) {}
 
-    while (running)
+    void enter() override
     {
-        Uint32 now = SDL_GetTicks();
-        float dt = (now - last) / 1000.0f;
-        last = now;
-
-        SDL_Event e;
-        while (SDL_PollEvent(&e))
+        TextureCache &textures = TextureCache::instance();
+        texBG = textures.acquire(ren, "assets/images/monster_background.png");
+        bool spritesLoaded = sprites.load(ren, "assets/atlas/monster",
+                                          {"assets/images/hero.png", "assets/images/enemy.png",
+                                           "assets/images/bullet_player.png", "assets/images/bullet_enemy.png"});
+
+        bgm = Mix_LoadMUS("assets/audio/starwars.wav");
+        sfxShootP = SoundBank::instance().get("assets/audio/shoot_player.mp3");
+        sfxShootE = SoundBank::instance().get("assets/audio/shoot_enemy.mp3");
+
+        font = FontRegistry::instance().get("CALIBRIL.TTF", 48);
+        if (!texBG || !spritesLoaded || !bgm || !sfxShootP || !sfxShootE || !font)
         {
-            if (e.type == SDL_QUIT)
-                return;
-            if (e.type == SDL_KEYDOWN)
-            {
-                if (e.key.keysym.sym == SDLK_ESCAPE)
-                    paused = !paused;
-                if (!paused && !gameOver && e.key.keysym.sym == SDLK_SPACE)
-                {
-                    Mix_PlayChannel(-1, sfxShootP, 0);
-                    Vec2 bulletStart = {player.pos.x + (64 * heroScale) / 2 - 8, player.pos.y + (64 * heroScale) / 2 - 8};
-                    Shoot(playerBullets, bulletStart, {300, 0});
-                }
-            }
+            SDL_Log("Asset load error: %s", SDL_GetError());
+            finish(false);
+            return;
         }
 
-        if (!paused && !gameOver)
+        Mix_PlayMusic(bgm, -1);
+
+        player = {{121, 400}, 100};
+        monster = {{569, SCREEN_H - 100 - 64 * enemScale}, 100};
+        playerBullets.clear();
+        monsterBullets.clear();
+        monsterTimer = monsterMoveTimer = 0;
+        gameOver = paused = false;
+        playerWon = false;
+    }
+
+    void exit() override
+    {
+        // Stop the sound when game is over (win/lose)
+        Mix_HaltMusic();
+        Mix_HaltChannel(-1);
+        if (bgm)
+            Mix_FreeMusic(bgm);
+        bgm = nullptr;
+    }
+
+    void handleEvent(const SDL_Event &e) override
+    {
+        if (e.type == SDL_KEYDOWN)
         {
-            const Uint8 *ks = SDL_GetKeyboardState(NULL);
-            float speed = 200.0f, dx = 0, dy = 0;
-            if (ks[SDL_SCANCODE_LEFT])
-                dx -= 1;
-            if (ks[SDL_SCANCODE_RIGHT])
-                dx += 1;
-            if (ks[SDL_SCANCODE_UP])
-                dy -= 1;
-            if (ks[SDL_SCANCODE_DOWN])
-                dy += 1;
-            float len = std::sqrt(dx * dx + dy * dy);
-            if (len)
+            if (e.key.keysym.sym == SDLK_ESCAPE)
+                paused = !paused;
+            if (!paused && !gameOver && e.key.keysym.sym == SDLK_SPACE)
             {
-                dx /= len;
-                dy /= len;
-                player.pos.x += dx * speed * dt;
-                player.pos.y += dy * speed * dt;
+                Mix_PlayChannel(-1, sfxShootP, 0);
+                Vec2 bulletStart = {player.pos.x + (64 * heroScale) / 2 - 8, player.pos.y + (64 * heroScale) / 2 - 8};
+                Shoot(playerBullets, bulletStart, {300, 0});
             }
-            player.pos.x = clamp(player.pos.x, 0, SCREEN_W - 64 * heroScale);
-            player.pos.y = clamp(player.pos.y, 0, SCREEN_H - 64 * heroScale);
+        }
+    }
 
-            monsterTimer += dt;
-            if (monsterTimer >= monsterInterval)
-            {
-                Mix_PlayChannel(-1, sfxShootE, 0);
-                for (int i = 0; i < 3; ++i)
-                {
-                    float offsetY = float(rand() % int(64 * enemScale));
-                    float dxm = player.pos.x - monster.pos.x;
-                    float dym = player.pos.y - monster.pos.y;
-                    float baseAngle = atan2f(dym, dxm);
-                    float deviation = ((rand() % 2001) - 1000) / 100.0f;
-                    float finalAngle = baseAngle + deviation * M_PI / 180.0f;
-                    Vec2 velocity = {cosf(finalAngle) * 300, sinf(finalAngle) * 300};
-                    Vec2 bulletStart = {monster.pos.x + 64 * enemScale / 2 - 8, monster.pos.y + offsetY};
-                    Shoot(monsterBullets, bulletStart, velocity);
-                }
-                monsterTimer = 0;
-            }
+    void update(double step) override
+    {
+        float dt = float(step);
 
-            monsterMoveTimer += dt;
-            if (monsterMoveTimer >= monsterMoveInterval)
-            {
-                monster.pos.x = rand() % (SCREEN_W - int(64 * enemScale));
-                monster.pos.y = rand() % (SCREEN_H - int(64 * enemScale));
-                monsterMoveTimer = 0;
-            }
+        if (gameOver && FrameScheduler::gameTicks() - gameOverStartTime >= GAME_OVER_DISPLAY_TIME)
+        {
+            if (playerWon)
+                recordWin(ctx);
+            finish(playerWon);
+            return;
+        }
+
+        if (paused || gameOver)
+            return;
+
+        const InputState &input = InputState::instance();
+        float speed = 200.0f, dx = 0, dy = 0;
+        if (input.isKeyDown(SDL_SCANCODE_LEFT))
+            dx -= 1;
+        if (input.isKeyDown(SDL_SCANCODE_RIGHT))
+            dx += 1;
+        if (input.isKeyDown(SDL_SCANCODE_UP))
+            dy -= 1;
+        if (input.isKeyDown(SDL_SCANCODE_DOWN))
+            dy += 1;
+        float len = std::sqrt(dx * dx + dy * dy);
+        if (len)
+        {
+            dx /= len;
+            dy /= len;
+            player.pos.x += dx * speed * dt;
+            player.pos.y += dy * speed * dt;
+        }
+        player.pos.x = clamp(player.pos.x, 0, SCREEN_W - 64 * heroScale);
+        player.pos.y = clamp(player.pos.y, 0, SCREEN_H - 64 * heroScale);
 
-            UpdateBullets(playerBullets, dt);
-            UpdateBullets(monsterBullets, dt);
-
-            SDL_Rect mR = {int(monster.pos.x), int(monster.pos.y), int(64 * enemScale), int(64 * enemScale)};
-            SDL_Rect pR = {int(player.pos.x), int(player.pos.y), int(64 * heroScale), int(64 * heroScale)};
-            for (auto &b : playerBullets)
-                if (b.active && CircleRect(b.pos, 5, mR))
-                {
-                    monster.health -= 1;
-                    b.active = false;
-                }
-            for (auto &b : monsterBullets)
-                if (b.active && CircleRect(b.pos, 5, pR))
-                {
-                    player.health -= 3;
-                    b.active = false;
-                }
-
-            if (player.health <= 0 || monster.health <= 0)
+        monsterTimer += dt;
+        if (monsterTimer >= monsterInterval)
+        {
+            Mix_PlayChannel(-1, sfxShootE, 0);
+
+            // The whole volley's spread is drawn in one go
+            const int VOLLEY = 3;
+            uint32_t offsets[VOLLEY];
+            float deviations[VOLLEY];
+            Rng &rng = RngService::instance().stream(RngService::MONSTER);
+            rng.fillBelow(uint32_t(64 * enemScale), offsets, VOLLEY);
+            rng.fillUniform(-10.0f, 10.0f, deviations, VOLLEY);
+
+            float dxm = player.pos.x - monster.pos.x;
+            float dym = player.pos.y - monster.pos.y;
+            float baseAngle = atan2f(dym, dxm);
+            for (int i = 0; i < VOLLEY; ++i)
             {
-                gameOver = true;
-                playerWon = (monster.health <= 0);
-                gameOverStartTime = SDL_GetTicks();
+                float offsetY = float(offsets[i]);
+                float finalAngle = baseAngle + deviations[i] * M_PI / 180.0f;
+                Vec2 velocity = {cosf(finalAngle) * 300, sinf(finalAngle) * 300};
+                Vec2 bulletStart = {monster.pos.x + 64 * enemScale / 2 - 8, monster.pos.y + offsetY};
+                Shoot(monsterBullets, bulletStart, velocity);
             }
+            monsterTimer = 0;
         }
 
-        if (gameOver && SDL_GetTicks() - gameOverStartTime >= GAME_OVER_DISPLAY_TIME)
+        monsterMoveTimer += dt;
+        if (monsterMoveTimer >= monsterMoveInterval)
         {
-            // Stop the sound when game is over (win/lose)
-            Mix_HaltMusic();
-            Mix_HaltChannel(-1);
+            Rng &rng = RngService::instance().stream(RngService::MONSTER);
+            monster.pos.x = rng.below(SCREEN_W - int(64 * enemScale));
+            monster.pos.y = rng.below(SCREEN_H - int(64 * enemScale));
+            monsterMoveTimer = 0;
+        }
+
+        UpdateBullets(playerBullets, dt);
+        UpdateBullets(monsterBullets, dt);
+
+        SDL_Rect mR = {int(monster.pos.x), int(monster.pos.y), int(64 * enemScale), int(64 * enemScale)};
+        SDL_Rect pR = {int(player.pos.x), int(player.pos.y), int(64 * heroScale), int(64 * heroScale)};
+        monster.health -= 1 * HitBullets(playerBullets, mR);
+        player.health -= 3 * HitBullets(monsterBullets, pR);
 
-            running = false;
+        if (player.health <= 0 || monster.health <= 0)
+        {
+            gameOver = true;
+            playerWon = (monster.health <= 0);
+            gameOverStartTime = FrameScheduler::gameTicks();
         }
+    }
 
+    void render(SDL_Renderer *ren, float alpha) override
+    {
         SDL_RenderClear(ren);
         SDL_RenderCopy(ren, texBG, nullptr, nullptr);
         SDL_Rect dstH = {int(player.pos.x), int(player.pos.y), int(64 * heroScale), int(64 * heroScale)};
         SDL_Rect dstM = {int(monster.pos.x), int(monster.pos.y), int(64 * enemScale), int(64 * enemScale)};
-        SDL_RenderCopy(ren, texHero, nullptr, &dstH);
-        SDL_RenderCopy(ren, texEnem, nullptr, &dstM);
-        DrawBar(ren, {player.pos.x - 30, player.pos.y - 20}, player.health, {0, 255, 0, 255});
-        DrawBar(ren, {monster.pos.x - 30, monster.pos.y - 20}, monster.health, {255, 165, 0, 255});
-
-        for (auto &b : playerBullets)
-            if (b.active)
-            {
-                SDL_Rect d = {int(b.pos.x), int(b.pos.y), 16, 16};
-                SDL_RenderCopy(ren, texPB, nullptr, &d);
-            }
-        for (auto &b : monsterBullets)
-            if (b.active)
-            {
-                SDL_Rect d = {int(b.pos.x), int(b.pos.y), 16, 16};
-                SDL_RenderCopy(ren, texEB, nullptr, &d);
-            }
+        sprites.queue(HERO_SPRITE, dstH);
+        sprites.queue(MONSTER_SPRITE, dstM);
+        sprites.flush(ren);
+        DrawBar(batch, {player.pos.x - 30, player.pos.y - 20}, player.health, {0, 255, 0, 255});
+        DrawBar(batch, {monster.pos.x - 30, monster.pos.y - 20}, monster.health, {255, 165, 0, 255});
+        batch.flush();
+
+        // Every bullet on screen in one draw call
+        for (int i = 0; i < playerBullets.count; ++i)
+            sprites.queue(PLAYER_BULLET_SPRITE, {int(playerBullets.x[i]), int(playerBullets.y[i]), 16, 16});
+        for (int i = 0; i < monsterBullets.count; ++i)
+            sprites.queue(MONSTER_BULLET_SPRITE, {int(monsterBullets.x[i]), int(monsterBullets.y[i]), 16, 16});
+        sprites.flush(ren);
 
         if (paused)
         {
             SDL_Color white = {255, 255, 255, 255};
-            SDL_Surface *surf = TTF_RenderText_Solid(font, "PAUSED", white);
-            SDL_Texture *tex = SDL_CreateTextureFromSurface(ren, surf);
-            SDL_Rect rect = {SCREEN_W / 2 - surf->w / 2, SCREEN_H / 2 - surf->h / 2, surf->w, surf->h};
-            SDL_RenderCopy(ren, tex, nullptr, &rect);
-            SDL_FreeSurface(surf);
-            SDL_DestroyTexture(tex);
+            SDL_Rect rect = measureText(ren, font, "PAUSED");
+            drawText(ren, font, "PAUSED", white, SCREEN_W / 2 - rect.w / 2, SCREEN_H / 2 - rect.h / 2);
         }
 
         if (gameOver)
         {
             SDL_Color red = {255, 0, 0, 255};
             const char *msg = playerWon ? "YOU WIN!" : "YOU LOSE!";
-            SDL_Surface *surf = TTF_RenderText_Solid(font, msg, red);
-            SDL_Texture *tex = SDL_CreateTextureFromSurface(ren, surf);
-            SDL_Rect dst = {SCREEN_W / 2 - surf->w / 2, SCREEN_H / 2 - surf->h / 2, surf->w, surf->h};
-            SDL_RenderCopy(ren, tex, nullptr, &dst);
-            SDL_FreeSurface(surf);
-            SDL_DestroyTexture(tex);
+            SDL_Rect dst = measureText(ren, font, msg);
+            drawText(ren, font, msg, red, SCREEN_W / 2 - dst.w / 2, SCREEN_H / 2 - dst.h / 2);
         }
-
-        SDL_RenderPresent(ren);
     }
 
-    if (playerWon)
-    {
-        TTF_Font *font = TTF_OpenFont("assets/fonts/arial.ttf", 36);
-        if (font)
-        {
-            Leaderboard leaderboard(font);
-            leaderboard.loadFromFile("leaderboard.txt");
-
-            using namespace std::chrono;
-            float timeSpent = duration_cast<duration<float>>(steady_clock::now() - ctx.startTime).count();
-
-            // Divide by 100 to convert to seconds
-            timeSpent /= 100.0f;
-
-            // Add only if leaderboard has < 5 players or current time is better than the slowest
-            if (leaderboard.players.size() < 5 || timeSpent < leaderboard.players.back().time)
-            {
-                leaderboard.players.emplace_back(ctx.playerName, timeSpent);
-
-                // Sort in descending order based on timeSpent (fastest times at the top)
-                std::sort(leaderboard.players.begin(), leaderboard.players.end(), [](const Player &a, const Player &b)
-                          {
-                              return a.time < b.time; // Ascending order for fastest times at the top
-                          });
-
-                if (leaderboard.players.size() > 5)
-                    leaderboard.players.resize(5); // Keep only the top 5 players
-
-                leaderboard.saveToFile("leaderboard.txt");
-            }
-
-            TTF_CloseFont(font);
-        }
+private:
+    const float heroScale = (100.0f / 64.0f) * 2.5f;
+    const float enemScale = (100.0f / 64.0f) * 2.5f;
+
+    SDL_Renderer *ren;
+    GameContext &ctx;
+    PrimitiveBatch batch;
+    TextureHandle texBG;
+    SpriteAtlas sprites;
+    Mix_Music *bgm = nullptr;
+    Mix_Chunk *sfxShootP = nullptr;
+    Mix_Chunk *sfxShootE = nullptr;
+    TTF_Font *font = nullptr;
+};
 
-        ctx.nextState = MENU; // Go back to menu after leaderboard update
-    }
-    else
-    {
-        ctx.nextState = MENU;
-    }
-}
\ No newline at end of file
+std::unique_ptr<Scene> createMonsterScene(SDL_Renderer *ren, GameContext &ctx)
+{
+    return std::make_unique<MonsterScene>(ren, ctx);
+}
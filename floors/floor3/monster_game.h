@@ -2,8 +2,11 @@
 #define MONSTER_GAME_H
 
 #include <SDL2/SDL.h>
+#include <memory>
 #include "../../common/GameContext.h"
+#include "../../common/scene.h"
 
-void runMonsterGame(SDL_Renderer* renderer, GameContext& ctx);
+// Final boss; records the run on the leaderboard when it is won
+std::unique_ptr<Scene> createMonsterScene(SDL_Renderer* renderer, GameContext& ctx);
 
 #endif
@@ -7,43 +7,116 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
-#include <ctime>
+#include "../../common/texture_cache.h"
+#include "../../common/text_renderer.h"
+#include "../../common/font_registry.h"
+#include "../../common/sound_bank.h"
+#include "../../common/frame_scheduler.h"
+#include "../../common/input_state.h"
+#include "../../common/rng.h"
+#include "../../common/primitive_batch.h"
+#include "../../common/sprite_atlas.h"
+#include "../../common/spatial_grid.h"
+#include "../../common/scene.h"
 
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
 const int WIN_SCORE = 300;
 
+// Speeds are in pixels per second; the simulation runs on FrameScheduler's
+// fixed step, so they no longer depend on the frame rate
+const float PLAYER_SPEED = 420.0f;
+const float BULLET_SPEED = -600.0f;
+const float SPAWN_INTERVAL = 1.0f;
+
+// Pool sizes in normal play: a second's worth of enemies crosses the
+// screen in under five, and a bullet in one
+const int MAX_BULLETS = 64;
+const int MAX_ENEMIES = 64;
+
+// Stress mode: enemies per second added to the spawn rate every second,
+// up to STRESS_MAX_ENEMIES alive at once. The ship fires a volley every
+// STRESS_FIRE_INTERVAL, one bullet wider per second up to STRESS_MAX_VOLLEY.
+const float STRESS_SPAWN_RAMP = 60.0f;
+const int STRESS_MAX_ENEMIES = 5000;
+const float STRESS_FIRE_INTERVAL = 0.05f;
+const int STRESS_MAX_VOLLEY = 40;
+
+// Sized to hold an enemy or a bullet in at most four cells
+const int COLLISION_CELL_SIZE = 64;
+
 struct Bullet {
-    SDL_Rect rect;
-    int speed = -10;
-    Bullet(SDL_Rect r, int s = -10) : rect(r), speed(s) {}
+    float x, y;
+    float prevY;  // position at the previous step, for interpolation
+    float speed = BULLET_SPEED;
+    bool dead = false;
+    SDL_Rect rect() const { return {int(x), int(y), 10, 20}; }
 };
 
 struct Enemy {
-    SDL_Rect rect;
-    std::string label;
-    int speed = 1;
+    float x, y;
+    float prevY;
+    int label;  // index into the scene's labels
+    float speed = 60.0f;
+    bool dead = false;
+    SDL_Rect rect() const { return {int(x), int(y), 60, 40}; }
 };
 
-bool checkCollision(SDL_Rect a, SDL_Rect b) {
-    return SDL_HasIntersection(&a, &b);
-}
+// ----------------------------------------------------
+// Pool keeps live entities packed at the front of one vector. Removing
+// one moves the last into its place instead of shifting everything after
+// it, so removal is O(1) and order is not preserved. The capacity is
+// reserved up front and never exceeded: add() refuses an item once the
+// pool is full, so spawning does not allocate in play.
+// ----------------------------------------------------
+template <typename T>
+class Pool {
+public:
+    explicit Pool(size_t capacity) : capacity(capacity) { items.reserve(capacity); }
+
+    // False, and nothing added, if the pool is full
+    bool add(const T& item) {
+        if (full()) return false;
+        items.push_back(item);
+        return true;
+    }
+    void remove(size_t i) {
+        items[i] = items.back();
+        items.pop_back();
+    }
 
-void renderText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color, int x, int y) {
-    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-    if (!surface) return;
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!texture) return;
-    SDL_Rect dst = {x, y, 0, 0};
-    SDL_QueryTexture(texture, NULL, NULL, &dst.w, &dst.h);
-    SDL_RenderCopy(renderer, texture, NULL, &dst);
-    SDL_DestroyTexture(texture);
+    // Removes every item flagged dead
+    void sweep() {
+        for (size_t i = 0; i < items.size();) {
+            if (items[i].dead) remove(i);  // look at what moved into i next
+            else ++i;
+        }
+    }
+
+    size_t size() const { return items.size(); }
+    bool full() const { return items.size() == capacity; }
+    T& operator[](size_t i) { return items[i]; }
+    typename std::vector<T>::iterator begin() { return items.begin(); }
+    typename std::vector<T>::iterator end() { return items.end(); }
+
+private:
+    size_t capacity;
+    std::vector<T> items;
+};
+
+// Sprite ids in the shooter atlas, in the order enter() lists them
+enum ShooterSprite { PLAYER_SHIP, ENEMY_SHIP };
+
+// Where something is drawn between two simulation steps
+static int lerp(float previous, float current, float alpha) {
+    return int(previous + (current - previous) * alpha);
 }
 
 std::string generateEncryptedCode() {
+    uint32_t letters[16];
+    RngService::instance().stream(RngService::SHOOTER).fillBelow(26, letters, 16);
     std::string code = "Encrypted code: ";
-    for (int i = 0; i < 16; ++i) code += char('A' + rand() % 26);
+    for (uint32_t letter : letters) code += char('A' + letter);
     return code;
 }
 
@@ -53,113 +126,287 @@ void showEndScreen(SDL_Renderer* renderer, TTF_Font* font, int score, bool won)
     SDL_Color red   = {255,0,0,255};
     SDL_SetRenderDrawColor(renderer, 0,0,0,255);
     SDL_RenderClear(renderer);
-    renderText(renderer, font, "Game Over!", white, 320, 180);
-    renderText(renderer, font, "Score: " + std::to_string(score), white, 300, 240);
-    if (won) renderText(renderer, font, "You killed all enemies!", green, 220, 300);
-    else     renderText(renderer, font, "Try Again!", red, 300, 300);
-    SDL_RenderPresent(renderer);
-    SDL_Delay(3000);
+    drawText(renderer, font, "Game Over!", white, 320, 180);
+    drawText(renderer, font, "Score: " + std::to_string(score), white, 300, 240);
+    if (won) drawText(renderer, font, "You killed all enemies!", green, 220, 300);
+    else     drawText(renderer, font, "Try Again!", red, 300, 300);
 }
 
-bool runSpaceShooterGame(SDL_Renderer* renderer) {
-    srand((unsigned)time(NULL));
+// ----------------------------------------------------
+// SpaceShooterScene: shoot the falling coursework before any of it reaches
+// the bottom. The end screen stays up for three seconds either way.
+//
+// Each step the enemies go into a SpatialGrid and every bullet is tested
+// against the enemies sharing its cells, so every hit in the step is
+// resolved and the cost follows the number of near pairs, not bullets
+// times enemies. The dead are swept out of their pools afterwards.
+//
+// ShooterMode::STRESS never ends: the spawn rate ramps up until thousands
+// of enemies are on screen, the ship fires ever wider volleys by itself and
+// enemies that get through are removed. On exit it prints the time spent
+// on collisions and removal, for measuring how they scale.
+// ----------------------------------------------------
+class SpaceShooterScene : public Scene {
+public:
+    SpaceShooterScene(SDL_Renderer* renderer, ShooterMode mode)
+        : renderer(renderer), batch(renderer), stress(mode == ShooterMode::STRESS),
+          bullets(stress ? STRESS_MAX_VOLLEY * MAX_BULLETS : MAX_BULLETS),
+          enemies(stress ? STRESS_MAX_ENEMIES : MAX_ENEMIES),
+          grid(COLLISION_CELL_SIZE) {}
 
-    Mix_Music* bgm      = Mix_LoadMUS("assets/audio/spaceshooter_background.mp3");
-    Mix_Chunk* shootSnd = Mix_LoadWAV("assets/audio/space_shoot.mp3");
-    if (bgm) Mix_PlayMusic(bgm, -1);
+    void enter() override {
+        bgm      = Mix_LoadMUS("assets/audio/spaceshooter_background.mp3");
+        shootSnd = SoundBank::instance().get("assets/audio/space_shoot.mp3");
+        if (bgm) Mix_PlayMusic(bgm, -1);
 
-    TTF_Font* font = TTF_OpenFont("assets/fonts/arial.ttf", 24);
-    if (!font) return false;
+        font = FontRegistry::instance().get("arial.ttf", 24);
+        if (!font) {
+            finish(false);
+            return;
+        }
 
-    SDL_Texture* bgTex = IMG_LoadTexture(renderer, "assets/images/space_background.png");
-    SDL_Texture* playerTex = IMG_LoadTexture(renderer, "assets/images/ship1.png");
-    SDL_Texture* enemyTex = IMG_LoadTexture(renderer, "assets/images/ship2.png");
+        bgTex = TextureCache::instance().acquire(renderer, "assets/images/space_background.png");
+        sprites.load(renderer, "assets/atlas/shooter", {"assets/images/ship1.png", "assets/images/ship2.png"});
+        // The labels in white, tinted with the glow as they are drawn
+        std::vector<SDL_Surface*> rendered;
+        for (const std::string& label : labels)
+            rendered.push_back(TTF_RenderUTF8_Blended(font, label.c_str(), {255,255,255,255}));
+        labelSheet.fromSurfaces(renderer, "shooter/labels", rendered);
+    }
 
-    SDL_Rect player = { SCREEN_WIDTH/2 - 25, SCREEN_HEIGHT - 60, 50, 40 };
-    std::vector<Bullet> bullets;
-    std::vector<Enemy> enemies;
-    std::string labels[] = {"PROJECT","QUIZ","LAB","EXAM"};
+    void exit() override {
+        Mix_HaltMusic();
+        if (bgm) Mix_FreeMusic(bgm);
+        bgm = nullptr;
+        if (scoreTex) SDL_DestroyTexture(scoreTex);
+        scoreTex = nullptr;
 
-    int score = 0;
-    bool quit = false;
-    SDL_Event e;
-    Uint32 lastSpawnTime = SDL_GetTicks();
-
-    while (!quit) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) return false;
-            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE) {
-                bullets.push_back(Bullet{ SDL_Rect{player.x + player.w/2 - 5, player.y, 10, 20} });
-                Mix_PlayChannel(-1, shootSnd, 0);
-            }
+        if (stress && steps > 0) {
+            std::cout << "Shooter stress: " << steps << " steps, peak " << peakEnemies << " enemies / "
+                      << peakBullets << " bullets, " << kills << " kills, collisions "
+                      << collisionMs / steps << " ms avg, " << worstCollisionMs << " ms worst" << std::endl;
         }
+    }
 
-        const Uint8* keys = SDL_GetKeyboardState(NULL);
-        if (keys[SDL_SCANCODE_LEFT]  && player.x > 0) player.x -= 7;
-        if (keys[SDL_SCANCODE_RIGHT] && player.x < SCREEN_WIDTH - player.w) player.x += 7;
+    void handleEvent(const SDL_Event& e) override {
+        if (ended) return;
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE) {
+            fire(playerX + player.w/2 - 5);
+            Mix_PlayChannel(-1, shootSnd, 0);
+        }
+    }
 
-        for (auto& b : bullets) b.rect.y += b.speed;
-        bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](Bullet& b){ return b.rect.y < 0; }), bullets.end());
+    void update(double step) override {
+        float dt = float(step);
 
-        Uint32 current = SDL_GetTicks();
-        if (current - lastSpawnTime > 1000) {
-            Enemy en; en.rect = { rand() % (SCREEN_WIDTH-60), 0, 60, 40 };
-            en.label = labels[rand()%4]; en.speed = 2 + rand()%3;
-            enemies.push_back(en);
-            lastSpawnTime = current;
+        if (ended) {
+            endTimer -= dt;
+            if (endTimer <= 0.0f) finish(won);
+            return;
         }
 
-        for (auto& en : enemies) en.rect.y += en.speed;
+        prevPlayerX = playerX;
+        const InputState& input = InputState::instance();
+        if (input.isKeyDown(SDL_SCANCODE_LEFT))  playerX -= PLAYER_SPEED * dt;
+        if (input.isKeyDown(SDL_SCANCODE_RIGHT)) playerX += PLAYER_SPEED * dt;
+        playerX = std::clamp(playerX, 0.0f, float(SCREEN_WIDTH - player.w));
 
-        for (size_t i = 0; i < bullets.size(); ++i) {
-            for (size_t j = 0; j < enemies.size(); ++j) {
-                if (checkCollision(bullets[i].rect, enemies[j].rect)) {
-                    bullets.erase(bullets.begin()+i);
-                    enemies.erase(enemies.begin()+j);
-                    score += 10;
-                    goto POST_COLLISION;
-                }
+        if (stress) {
+            elapsed += dt;
+            fireTimer += dt;
+            while (fireTimer >= STRESS_FIRE_INTERVAL) {
+                fireVolley(std::min(STRESS_MAX_VOLLEY, 1 + int(elapsed)));
+                fireTimer -= STRESS_FIRE_INTERVAL;
             }
         }
-        POST_COLLISION:;
 
+        for (auto& b : bullets) {
+            b.prevY = b.y;
+            b.y += b.speed * dt;
+            if (b.y < 0) b.dead = true;
+        }
+
+        // Normal play spawns one a second; stress mode ever more
+        spawnTimer += dt;
+        float interval = stress ? 1.0f / (STRESS_SPAWN_RAMP * elapsed) : SPAWN_INTERVAL;
+        while (spawnTimer >= interval && !enemies.full()) {
+            spawnEnemy();
+            spawnTimer -= interval;
+        }
+        // A full pool spawns nothing, and does not bank the time either
+        if (enemies.full()) spawnTimer = std::min(spawnTimer, interval);
+
+        for (auto& en : enemies) { en.prevY = en.y; en.y += en.speed * dt; }
+
+        Uint64 collisionStart = SDL_GetPerformanceCounter();
+        resolveHits();
+        bool escaped = false;
         for (auto& en : enemies) {
-            if (en.rect.y > SCREEN_HEIGHT) {
-                showEndScreen(renderer, font, score, false);
-                Mix_HaltMusic(); Mix_FreeMusic(bgm); Mix_FreeChunk(shootSnd);
-                SDL_DestroyTexture(bgTex); SDL_DestroyTexture(playerTex); SDL_DestroyTexture(enemyTex);
-                TTF_CloseFont(font);
-                return false;
+            if (en.y > SCREEN_HEIGHT) {
+                escaped = true;
+                en.dead = true;
             }
         }
+        bullets.sweep();
+        enemies.sweep();
+        if (stress) recordStep(collisionStart);
+
+        if (escaped && !stress) endGame(false);
+        else if (score >= WIN_SCORE && !stress) endGame(true);
+    }
+
+    void render(SDL_Renderer* renderer, float alpha) override {
+        if (ended) {
+            showEndScreen(renderer, font, score, won);
+            return;
+        }
 
-        if (score >= WIN_SCORE) quit = true;
+        player.x = lerp(prevPlayerX, playerX, alpha);
 
         SDL_SetRenderDrawColor(renderer, 0,0,0,255);
         SDL_RenderClear(renderer);
         SDL_RenderCopy(renderer, bgTex, NULL, NULL);
-        SDL_RenderCopy(renderer, playerTex, NULL, &player);
-
+        // Ships first in one draw call, then their labels on top
+        sprites.queue(PLAYER_SHIP, player);
         for (auto& en : enemies) {
-            SDL_RenderCopy(renderer, enemyTex, NULL, &en.rect);
-            SDL_Color glow = {(Uint8)(128 + 127 * sin(SDL_GetTicks()/300.0)), 200, 255, 255};
-            renderText(renderer, font, en.label, glow, en.rect.x+5, en.rect.y+10);
+            SDL_Rect dst = en.rect();
+            dst.y = lerp(en.prevY, en.y, alpha);
+            sprites.queue(ENEMY_SHIP, dst);
+        }
+        sprites.flush(renderer);
+
+        SDL_Color glow = {(Uint8)(128 + 127 * sin(FrameScheduler::gameTicks()/300.0)), 200, 255, 255};
+        if (labelSheet.isLoaded()) {
+            for (auto& en : enemies) {
+                const SDL_Rect& size = labelSheet.rect(en.label);
+                labelSheet.queue(en.label, {int(en.x)+5, lerp(en.prevY, en.y, alpha)+10, size.w, size.h});
+            }
+            labelSheet.flush(renderer, glow);
+        }
+
+        const SDL_Color bulletColor = {255,255,0,255};
+        for (auto& b : bullets) {
+            SDL_Rect dst = b.rect();
+            dst.y = lerp(b.prevY, b.y, alpha);
+            batch.fillRect(dst, bulletColor);
+        }
+        batch.flush();
+
+        drawScore(renderer);
+    }
+
+private:
+    void fire(float x) {
+        float y = float(player.y);
+        bullets.add(Bullet{x, y, y});
+    }
+
+    // count bullets spread evenly across the screen, the ship's among them
+    void fireVolley(int count) {
+        float shipX = playerX + player.w/2 - 5;
+        fire(shipX);
+        float spacing = float(SCREEN_WIDTH) / count;
+        for (int i = 1; i < count; ++i) fire(std::fmod(shipX + i * spacing, float(SCREEN_WIDTH - 10)));
+    }
+
+    void spawnEnemy() {
+        Rng& rng = RngService::instance().stream(RngService::SHOOTER);
+        Enemy en;
+        en.x = float(rng.below(SCREEN_WIDTH-60));
+        en.y = en.prevY = 0.0f;
+        en.label = int(rng.below(4));
+        en.speed = 60.0f * rng.range(2, 4);  // 2-4 px at the old fixed 60 fps
+        enemies.add(en);
+    }
+
+    // Each bullet kills the first live enemy it overlaps, and each enemy
+    // dies once; both are only flagged here and swept by the caller
+    void resolveHits() {
+        if (bullets.size() == 0 || enemies.size() == 0) return;
+
+        grid.clear();
+        for (size_t i = 0; i < enemies.size(); ++i) grid.insert(enemies[i].rect(), 1, int(i));
+
+        for (auto& b : bullets) {
+            if (b.dead) continue;
+            grid.query(b.rect(), candidates);
+            for (int id : candidates) {
+                Enemy& en = enemies[grid.value(id)];
+                if (en.dead) continue;
+                en.dead = b.dead = true;
+                score += 10;
+                ++kills;
+                break;
+            }
         }
+    }
 
-        SDL_SetRenderDrawColor(renderer, 255,255,0,255);
-        for (auto& b : bullets) SDL_RenderFillRect(renderer, &b.rect);
+    void recordStep(Uint64 collisionStart) {
+        double ms = double(SDL_GetPerformanceCounter() - collisionStart) * 1000.0 / double(SDL_GetPerformanceFrequency());
+        collisionMs += ms;
+        worstCollisionMs = std::max(worstCollisionMs, ms);
+        peakEnemies = std::max(peakEnemies, enemies.size());
+        peakBullets = std::max(peakBullets, bullets.size());
+        ++steps;
+    }
+
+    // The score texture is only rasterized again when the score changes
+    void drawScore(SDL_Renderer* renderer) {
+        if (!scoreTex || scoreShown != score) {
+            if (scoreTex) SDL_DestroyTexture(scoreTex);
+            scoreTex = nullptr;
+            SDL_Surface* surface = TTF_RenderUTF8_Blended(font, ("Score: " + std::to_string(score)).c_str(), {255,255,255,255});
+            if (surface) {
+                scoreTex = SDL_CreateTextureFromSurface(renderer, surface);
+                scoreRect = {10, 10, surface->w, surface->h};
+                SDL_FreeSurface(surface);
+            }
+            scoreShown = score;
+        }
+        if (scoreTex) SDL_RenderCopy(renderer, scoreTex, nullptr, &scoreRect);
+    }
 
-        renderText(renderer, font, "Score: " + std::to_string(score), {255,255,255,255}, 10, 10);
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+    void endGame(bool playerWon) {
+        ended = true;
+        won = playerWon;
+        endTimer = 3.0f;
     }
 
-    bool won = score >= WIN_SCORE;
-    showEndScreen(renderer, font, score, won);
+    SDL_Renderer* renderer;
+    PrimitiveBatch batch;
+    Mix_Music* bgm = nullptr;
+    Mix_Chunk* shootSnd = nullptr;
+    TTF_Font* font = nullptr;
+    TextureHandle bgTex;
+    SpriteAtlas sprites;
+
+    bool stress;
+
+    SDL_Rect player = { SCREEN_WIDTH/2 - 25, SCREEN_HEIGHT - 60, 50, 40 };
+    float playerX = float(player.x), prevPlayerX = playerX;
+    Pool<Bullet> bullets;
+    Pool<Enemy> enemies;
+    SpatialGrid grid;                 // the enemies, rebuilt every step
+    std::vector<int> candidates;      // reused by resolveHits()
+    std::string labels[4] = {"PROJECT","QUIZ","LAB","EXAM"};
+    SpriteAtlas labelSheet;           // labels, white, tinted per frame
+
+    SDL_Texture* scoreTex = nullptr;
+    SDL_Rect scoreRect = {10, 10, 0, 0};
+    int scoreShown = 0;               // the score scoreTex shows
+
+    int score = 0;
+    float spawnTimer = 0.0f;
+    bool ended = false, won = false;
+    float endTimer = 0.0f;  // end screen countdown
 
-    Mix_HaltMusic(); Mix_FreeMusic(bgm); Mix_FreeChunk(shootSnd);
-    SDL_DestroyTexture(bgTex); SDL_DestroyTexture(playerTex); SDL_DestroyTexture(enemyTex);
-    TTF_CloseFont(font);
+    // Stress mode only
+    float elapsed = 0.0f, fireTimer = 0.0f;
+    int kills = 0, steps = 0;
+    size_t peakEnemies = 0, peakBullets = 0;
+    double collisionMs = 0.0, worstCollisionMs = 0.0;
+};
 
-    return won;
+std::unique_ptr<Scene> createSpaceShooterScene(SDL_Renderer* renderer, ShooterMode mode) {
+    return std::make_unique<SpaceShooterScene>(renderer, mode);
 }
@@ -3,8 +3,15 @@
 #define SPACE_SHOOTER_H
 
 #include <SDL2/SDL.h>
+#include <memory>
+#include "../../common/scene.h"
 
-// ✅ Change return type to bool
-bool runSpaceShooterGame(SDL_Renderer* renderer);
+enum class ShooterMode {
+    NORMAL,
+    STRESS,  // endless, ramping to thousands of enemies; for benchmarks
+};
+
+// Finishes with true once WIN_SCORE is reached; STRESS never finishes
+std::unique_ptr<Scene> createSpaceShooterScene(SDL_Renderer* renderer, ShooterMode mode = ShooterMode::NORMAL);
 
 #endif
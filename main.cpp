@@ -6,9 +6,58 @@
 #include <SDL2/SDL_image.h>
 #include "UI/menu.h"
 #include "GameContext.h"
+#include "common/texture_cache.h"
+#include "common/text_renderer.h"
+#include "common/font_registry.h"
+#include "common/sound_bank.h"
+#include "common/asset_loader.h"
+#include "common/asset_pack.h"
+#include "common/frame_scheduler.h"
+#include "common/input_recorder.h"
+#include "common/rng.h"
+#include "common/run_log.h"
+#include "common/run_writer.h"
+#include "floors/floor1/floor1.h"
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 
 int main(int argc, char* argv[]) {
+    // Frame pacing: --fps <hz> (60, 120, 144...) and --vsync
+    // Input: --record <file>, --replay <file> [--fast], --seed <n>
+    int targetHz = FrameScheduler::DEFAULT_TARGET_HZ;
+    bool vsync = false;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    bool fastReplay = false;
+    bool seedGiven = false;
+    uint64_t seed = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) targetHz = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--vsync") == 0) vsync = true;
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--fast") == 0) fastReplay = true;
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            seedGiven = true;
+        }
+    }
+    FrameScheduler::configure(targetHz, vsync);
+
+    // One seed drives every random choice in the session, so a recording
+    // plus its seed reproduces the run exactly
+    InputReplay replay;
+    if (replayPath) {
+        if (!replay.open(replayPath)) return 1;
+        seed = replay.seed();
+    } else if (!seedGiven) {
+        seed = uint64_t(std::time(nullptr)) ^ SDL_GetPerformanceCounter();
+    }
+    RngService::instance().seed(seed);
+    std::cout << "Session seed " << seed << std::endl;
+
     // Initialize SDL core systems
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cerr << "SDL Initialization failed: " << SDL_GetError() << std::endl;
@@ -48,7 +97,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (vsync) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         std::cerr << "Failed to create renderer: " << SDL_GetError() << std::endl;
         SDL_DestroyWindow(window);
@@ -59,19 +110,56 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Open every font the game uses once, up front
+    FontRegistry& fonts = FontRegistry::instance();
+    fonts.setFallbackFace("DejaVuSans.ttf");
+    fonts.preload({
+        {"arial.ttf", 14}, {"arial.ttf", 24}, {"arial.ttf", 36},
+        {"impact.ttf", 24},
+        {"OpenSans-Bold.ttf", 20}, {"OpenSans-Bold.ttf", 36}, {"OpenSans-Bold.ttf", 48},
+        {"CALIBRIL.TTF", 48}
+    });
+
+    // Pre-decoded assets from `make assets.pak`; loose files are used if it is absent
+    AssetPack::instance().open("assets.pak");
+
+    // Decode floor 1 in the background while the menu is up; the loading
+    // screen in GameManager only has to upload what is already decoded
+    AssetLoader& loader = AssetLoader::instance();
+    loader.start();
+    loader.queue(renderer, floor1Assets());
+
     // Setup GameContext
     GameContext context;
     context.window = window;
     context.renderer = renderer;
 
+    // Every completed run; a replay must not add its run a second time
+    if (!replayPath) RunLog::instance().open("runs");
+    RunWriter::instance().start();
+
     // Run GameManager
     GameManager manager;
+    InputRecorder recorder;
+    if (replayPath) {
+        manager.setReplay(&replay, fastReplay);
+    } else if (recordPath && recorder.open(recordPath, seed)) {
+        manager.setRecorder(&recorder);
+    }
     manager.run(context);
+    recorder.close();
 
-    // Cleanup
+    // Cleanup; the last run reaches the disk before anything else closes
+    RunWriter::instance().shutdown();
+    loader.shutdown();
+    TextureCache::instance().clear();
+    clearTextCache();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
+    SoundBank::instance().clear();
+    AssetPack::instance().close();
     Mix_CloseAudio();  // ✅ Also close the audio device
+    fonts.clear();
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
@@ -0,0 +1,148 @@
+// tools/asset_packer.cpp
+// Builds assets.pak: every image decoded to ARGB8888 and every sound
+// decoded to the mixer's PCM format, so the game can map the file and
+// use the bytes as they are.
+//
+// Usage: asset_packer <output.pak> <asset> [<asset> ...]
+// *.png arguments are packed as images, everything else as sounds.
+// Paths are stored exactly as given, so run it from the repository root.
+#include "asset_pack.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Must match Mix_OpenAudio() in main.cpp
+static const int MIXER_FREQUENCY = 44100;
+static const int MIXER_CHANNELS = 2;
+
+struct PackedAsset {
+    PackEntry entry;
+    std::vector<unsigned char> bytes;
+};
+
+static bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static bool packImage(const std::string& path, PackedAsset& asset) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) {
+        std::cerr << "IMG_Load failed for " << path << ": " << IMG_GetError() << std::endl;
+        return false;
+    }
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    if (!surface) {
+        std::cerr << "Could not convert " << path << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    asset.entry.type = PackEntry::IMAGE;
+    asset.entry.width = surface->w;
+    asset.entry.height = surface->h;
+
+    // Drop any row padding so the pitch is always width * 4
+    size_t rowBytes = static_cast<size_t>(surface->w) * 4;
+    asset.bytes.resize(rowBytes * surface->h);
+    SDL_LockSurface(surface);
+    for (int y = 0; y < surface->h; ++y) {
+        std::memcpy(&asset.bytes[y * rowBytes],
+                    static_cast<unsigned char*>(surface->pixels) + y * surface->pitch, rowBytes);
+    }
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+static bool packSound(const std::string& path, PackedAsset& asset) {
+    // Mix_LoadWAV converts to the opened mixer format, which is what we store
+    Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
+    if (!chunk) {
+        std::cerr << "Mix_LoadWAV failed for " << path << ": " << Mix_GetError() << std::endl;
+        return false;
+    }
+    asset.entry.type = PackEntry::SOUND;
+    asset.bytes.assign(chunk->abuf, chunk->abuf + chunk->alen);
+    Mix_FreeChunk(chunk);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.pak> <asset> [<asset> ...]" << std::endl;
+        return 1;
+    }
+
+    // No window and no speakers needed
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0 || IMG_Init(IMG_INIT_PNG) == 0 ||
+        Mix_OpenAudio(MIXER_FREQUENCY, MIX_DEFAULT_FORMAT, MIXER_CHANNELS, 2048) < 0) {
+        std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    PackHeader header = {};
+    std::memcpy(header.magic, PACK_MAGIC, 4);
+    header.version = PACK_VERSION;
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    header.audioFrequency = frequency;
+    header.audioFormat = format;
+    header.audioChannels = static_cast<uint16_t>(channels);
+
+    std::vector<PackedAsset> assets;
+    for (int i = 2; i < argc; ++i) {
+        std::string path = argv[i];
+        if (path.size() >= sizeof(PackEntry::name)) {
+            std::cerr << "Path too long for the pack index: " << path << std::endl;
+            return 1;
+        }
+
+        PackedAsset asset = {};
+        std::strncpy(asset.entry.name, path.c_str(), sizeof(asset.entry.name) - 1);
+        bool ok = endsWith(path, ".png") ? packImage(path, asset) : packSound(path, asset);
+        if (!ok) return 1;
+        assets.push_back(std::move(asset));
+    }
+    header.entryCount = static_cast<uint32_t>(assets.size());
+
+    // Lay out payloads after the index, each aligned for the upload path
+    uint64_t offset = sizeof(PackHeader) + assets.size() * sizeof(PackEntry);
+    for (auto& asset : assets) {
+        offset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+        asset.entry.offset = offset;
+        asset.entry.size = asset.bytes.size();
+        offset += asset.bytes.size();
+    }
+
+    std::ofstream out(argv[1], std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot write " << argv[1] << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& asset : assets) out.write(reinterpret_cast<const char*>(&asset.entry), sizeof(PackEntry));
+    for (const auto& asset : assets) {
+        static const char padding[PACK_ALIGN] = {};
+        out.write(padding, asset.entry.offset - static_cast<uint64_t>(out.tellp()));
+        out.write(reinterpret_cast<const char*>(asset.bytes.data()), asset.bytes.size());
+    }
+    if (!out) {
+        std::cerr << "Write failed for " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << assets.size() << " assets into " << argv[1]
+              << " (" << offset / 1024 << " KiB)" << std::endl;
+
+    Mix_CloseAudio();
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,56 @@
+// tools/atlas_packer.cpp
+// Packs a minigame's sprites into one texture for SpriteAtlas: writes
+// <base>.png and the <base>.atlas sub-rect table next to it. Sprites are
+// shrunk so their longest side is at most --max-sprite pixels.
+//
+// Usage: atlas_packer [--max-sprite N] <base> <sprite.png> [<sprite.png> ...]
+// Source paths are stored exactly as given, so run it from the
+// repository root with the paths the game loads.
+#include "atlas_layout.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int maxSprite = ATLAS_MAX_SPRITE;
+    int arg = 1;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--max-sprite") == 0) {
+        maxSprite = std::atoi(argv[arg + 1]);
+        arg += 2;
+    }
+    if (argc - arg < 2 || maxSprite <= 0) {
+        std::cerr << "Usage: atlas_packer [--max-sprite N] <base> <sprite.png> [<sprite.png> ...]" << std::endl;
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0 || IMG_Init(IMG_INIT_PNG) == 0) {
+        std::cerr << "SDL/SDL_image Initialization failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    std::string base = argv[arg++];
+    std::vector<std::string> sources(argv + arg, argv + argc);
+    std::vector<AtlasRegion> regions;
+    SDL_Surface* atlas = buildAtlasSurface(sources, regions, maxSprite);
+    if (!atlas) return 1;
+
+    int status = 0;
+    if (IMG_SavePNG(atlas, (base + ".png").c_str()) != 0) {
+        std::cerr << "Could not write " << base << ".png: " << IMG_GetError() << std::endl;
+        status = 1;
+    } else if (!writeAtlasTable(base + ".atlas", regions, atlas->w, atlas->h)) {
+        std::cerr << "Could not write " << base << ".atlas" << std::endl;
+        status = 1;
+    } else {
+        std::cout << base << ": " << regions.size() << " sprites in " << atlas->w << "x" << atlas->h << std::endl;
+    }
+
+    SDL_FreeSurface(atlas);
+    IMG_Quit();
+    SDL_Quit();
+    return status;
+}
@@ -0,0 +1,459 @@
+// tools/escape_room_bench.cpp
+// Headless benchmark: runs the menu, every floor and every minigame scene
+// with a scripted input stream and reports throughput per scenario.
+//
+// Usage: escape-room-bench [--frames N] [--only <scenario>] [--list]
+//        escape-room-bench --replay-check
+// Run from the repository root so assets/ resolves. By default it uses
+// SDL's dummy video and audio drivers and the software renderer, so it
+// needs neither a display nor a GPU.
+//
+// Frames are not paced: each one handles the scripted events, advances the
+// simulation by 1/60 s in fixed steps, renders and presents, as fast as the
+// machine allows. Each scenario runs in its own child process, so the peak
+// RSS reported is that scenario's alone.
+//
+// --replay-check records a floor 1 session that scrolls the camera before
+// clicking a door, then replays it with and without rendering (as
+// --replay and --replay --fast do) and fails unless the door opens in both.
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/GameContext.h"
+#include "../common/scene.h"
+#include "../common/frame_scheduler.h"
+#include "../common/input_state.h"
+#include "../common/rng.h"
+#include "../common/texture_cache.h"
+#include "../common/text_renderer.h"
+#include "../common/font_registry.h"
+#include "../common/sound_bank.h"
+#include "../common/asset_pack.h"
+#include "../common/input_recorder.h"
+#include "../UI/menu.h"
+#include "../floors/floor1/floor1.h"
+#include "../floors/floor1/puzzle_game.h"
+#include "../floors/floor1/rsa_game.h"
+#include "../floors/floor2/floor2.h"
+#include "../floors/floor2/tetris_game.h"
+#include "../floors/floor2/circuit_game.h"
+#include "../floors/floor2/projection_game.h"
+#include "../floors/floor3/floor3.h"
+#include "../floors/floor3/space_shooter.h"
+#include "../floors/floor3/monster_game.h"
+
+static const int DEFAULT_FRAMES = 600;
+static const double FRAME_SECONDS = 1.0 / 60.0;
+static const uint64_t BENCH_SEED = 1;  // every run spawns the same enemies and pieces
+
+// ---------- scripted input ----------
+
+static void pushKey(SDL_Keycode sym) {
+    SDL_Event e = {};
+    e.type = SDL_KEYDOWN;
+    e.key.state = SDL_PRESSED;
+    e.key.keysym.sym = sym;
+    SDL_PushEvent(&e);
+    e.type = SDL_KEYUP;
+    e.key.state = SDL_RELEASED;
+    SDL_PushEvent(&e);
+}
+
+static void pushText(const char* text) {
+    SDL_Event e = {};
+    e.type = SDL_TEXTINPUT;
+    std::strncpy(e.text.text, text, sizeof(e.text.text) - 1);
+    SDL_PushEvent(&e);
+}
+
+// Held keys are read through InputState, which sees these like real ones
+static void pushHold(SDL_Scancode code, bool down) {
+    SDL_Event e = {};
+    e.type = down ? SDL_KEYDOWN : SDL_KEYUP;
+    e.key.state = down ? SDL_PRESSED : SDL_RELEASED;
+    e.key.keysym.scancode = code;
+    SDL_PushEvent(&e);
+}
+
+static void pushMotion(int x, int y) {
+    SDL_Event e = {};
+    e.type = SDL_MOUSEMOTION;
+    e.motion.x = x;
+    e.motion.y = y;
+    SDL_PushEvent(&e);
+}
+
+static void pushButton(Uint32 type, int x, int y) {
+    SDL_Event e = {};
+    e.type = type;
+    e.button.button = SDL_BUTTON_LEFT;
+    e.button.state = type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+    e.button.x = x;
+    e.button.y = y;
+    SDL_PushEvent(&e);
+}
+
+static void pushClick(int x, int y) {
+    pushButton(SDL_MOUSEBUTTONDOWN, x, y);
+    pushButton(SDL_MOUSEBUTTONUP, x, y);
+}
+
+// Walks in a square, one step every few frames
+static void walk(int frame) {
+    static const SDL_Keycode route[] = {SDLK_RIGHT, SDLK_DOWN, SDLK_LEFT, SDLK_UP};
+    if (frame % 4 == 0) pushKey(route[(frame / 64) % 4]);
+}
+
+// Strafes left and right for a second each while firing
+static void strafe(int frame) {
+    if (frame % 60 == 0) {
+        bool left = (frame / 60) % 2 == 0;
+        pushHold(left ? SDL_SCANCODE_RIGHT : SDL_SCANCODE_LEFT, false);
+        pushHold(left ? SDL_SCANCODE_LEFT : SDL_SCANCODE_RIGHT, true);
+    }
+    if (frame % 8 == 0) pushKey(SDLK_SPACE);
+}
+
+static void typeEvery(int frame, int interval, const std::string& text) {
+    if (frame % interval != 0) return;
+    size_t i = size_t(frame / interval) % (text.size() + 1);
+    if (i == text.size()) pushKey(SDLK_RETURN);
+    else pushText(text.substr(i, 1).c_str());
+}
+
+// ---------- scenarios ----------
+
+struct Scenario {
+    const char* name;
+    std::function<std::unique_ptr<Scene>(GameContext&)> create;
+    std::function<void(int frame)> script;
+};
+
+static std::vector<Scenario> scenarios() {
+    return {
+        {"menu", createMenuScene, [](int f) {
+            // Sweep the pointer over the buttons so hover states change
+            pushMotion(360, 160 + (f * 7) % 420);
+        }},
+        {"floor1", createFloor1Scene, walk},
+        {"floor2", createFloor2Scene, walk},
+        {"floor3", createFloor3Scene, walk},
+        {"puzzle", [](GameContext& ctx) { return createPuzzleScene(ctx.renderer); }, [](int f) {
+            if (f == 1) pushClick(576, 416);
+            else typeEvery(f, 5, "keyboard");
+        }},
+        {"rsa", [](GameContext& ctx) { return createRSAScene(ctx.renderer); }, [](int f) {
+            static const SDL_Point fields[] = {{300, 70}, {300, 140}, {300, 210}};
+            if (f % 60 == 0) pushClick(fields[(f / 60) % 3].x, fields[(f / 60) % 3].y);
+            else if (f % 60 == 59) pushClick(425, 280);  // Decrypt
+            else if (f % 3 == 0) pushText("2");
+        }},
+        {"tetris", [](GameContext& ctx) { return createTetrisScene(ctx.renderer); }, [](int f) {
+            static const SDL_Keycode keys[] = {SDLK_LEFT, SDLK_UP, SDLK_RIGHT, SDLK_DOWN};
+            if (f % 6 == 0) pushKey(keys[(f / 6) % 4]);
+        }},
+        {"circuit", [](GameContext& ctx) { return createCircuitScene(ctx.renderer, ctx); }, [](int f) {
+            // Drag each component around for 40 frames, then drop it
+            int comp = (f / 40) % 6, t = f % 40;
+            int x = 132 + comp * 100, y = 432;
+            if (t == 0) pushButton(SDL_MOUSEBUTTONDOWN, x, y);
+            else if (t < 39) pushMotion(x + t * 3, y - t * 4);
+            else pushButton(SDL_MOUSEBUTTONUP, x + t * 3, y - t * 4);
+        }},
+        {"projection", [](GameContext& ctx) { return createProjectionScene(ctx.renderer); }, [](int f) {
+            static const SDL_Keycode keys[] = {SDLK_LEFT, SDLK_UP, SDLK_RIGHT, SDLK_DOWN, SDLK_SPACE};
+            if (f % 5 == 0) pushKey(keys[(f / 5) % 5]);
+        }},
+        {"shooter", [](GameContext& ctx) { return createSpaceShooterScene(ctx.renderer); }, strafe},
+        {"shooter-stress", [](GameContext& ctx) {
+            return createSpaceShooterScene(ctx.renderer, ShooterMode::STRESS);
+        }, strafe},
+        {"monster", [](GameContext& ctx) { return createMonsterScene(ctx.renderer, ctx); }, [](int f) {
+            if (f % 10 == 0) pushKey(SDLK_SPACE);
+        }},
+    };
+}
+
+// ---------- runner ----------
+
+static bool initSDL(GameContext& ctx) {
+    // Headless unless the caller asked for something else
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
+        std::cerr << "SDL Initialization failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    if (IMG_Init(IMG_INIT_PNG) == 0 || TTF_Init() == -1) {
+        std::cerr << "SDL_image/SDL_ttf Initialization failed" << std::endl;
+        return false;
+    }
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+        std::cerr << "SDL_mixer Initialization failed: " << Mix_GetError() << std::endl;
+        return false;
+    }
+
+    ctx.window = SDL_CreateWindow("Escape Room Bench", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_SHOWN);
+    if (ctx.window) ctx.renderer = SDL_CreateRenderer(ctx.window, -1, SDL_RENDERER_SOFTWARE);
+    if (!ctx.renderer) {
+        std::cerr << "Failed to create window/renderer: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    FontRegistry::instance().setFallbackFace("DejaVuSans.ttf");
+    AssetPack::instance().open("assets.pak");
+    return true;
+}
+
+static void shutdownSDL(GameContext& ctx) {
+    TextureCache::instance().clear();
+    clearTextCache();
+    SDL_DestroyRenderer(ctx.renderer);
+    SDL_DestroyWindow(ctx.window);
+    SoundBank::instance().clear();
+    AssetPack::instance().close();
+    Mix_CloseAudio();
+    FontRegistry::instance().clear();
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+static double elapsedMs(Uint64 start) {
+    return double(SDL_GetPerformanceCounter() - start) * 1000.0 / double(SDL_GetPerformanceFrequency());
+}
+
+// Runs in the child process; prints one result row
+static int runScenario(const Scenario& scenario, int frames) {
+    GameContext ctx;
+    ctx.playerName = "bench";
+    if (!initSDL(ctx)) return 1;
+
+    RngService::instance().seed(BENCH_SEED);
+    InputState::instance().reset();
+
+    // Each frame is FRAME_SECONDS long as far as the game can tell
+    FrameScheduler frame;
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+    double enterMs = 0.0;
+    int restarts = 0;
+
+    {
+        SceneStack stack;
+        Uint64 start = SDL_GetPerformanceCounter();
+        stack.push(scenario.create(ctx));
+        stack.applyPending();
+        enterMs = elapsedMs(start);
+
+        Uint64 runStart = SDL_GetPerformanceCounter();
+        for (int f = 0; f < frames; ++f) {
+            Uint64 frameStart = SDL_GetPerformanceCounter();
+
+            frame.beginFrame(FRAME_SECONDS);
+            scenario.script(f);
+            SDL_Event e;
+            while (SDL_PollEvent(&e)) {
+                if (e.type == SDL_QUIT) continue;
+                InputState::instance().handleEvent(e);
+                stack.handleEvent(e);
+            }
+
+            while (frame.step()) stack.update(frame.stepSeconds());
+
+            stack.render(ctx.renderer, frame.alpha());
+            SDL_RenderPresent(ctx.renderer);
+
+            // A minigame that ends (won, lost, ESC) is started over;
+            // anything it asked GameManager for is ignored
+            stack.applyPending();
+            if (stack.empty()) {
+                stack.push(scenario.create(ctx));
+                stack.applyPending();
+                ++restarts;
+            }
+
+            frameMs.push_back(elapsedMs(frameStart));
+        }
+        double totalMs = elapsedMs(runStart);
+
+        std::vector<double> sorted = frameMs;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&](double p) {
+            return sorted[std::min(sorted.size() - 1, size_t(p * (sorted.size() - 1) + 0.5))];
+        };
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        std::printf("%-14s %9.1f %9.3f %9.3f %9.3f %10.1f %8d %12ld\n",
+                    scenario.name, frames * 1000.0 / totalMs, percentile(0.50), percentile(0.99),
+                    sorted.back(), enterMs, restarts, long(usage.ru_maxrss));
+        std::fflush(stdout);
+    }
+
+    shutdownSDL(ctx);
+    return 0;
+}
+
+// ---------- replay check ----------
+
+static SDL_Event keyEvent(Uint32 type, SDL_Keycode sym) {
+    SDL_Event e = {};
+    e.type = type;
+    e.key.state = type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+    e.key.keysym.sym = sym;
+    return e;
+}
+
+static SDL_Event buttonEvent(Uint32 type, int x, int y) {
+    SDL_Event e = {};
+    e.type = type;
+    e.button.button = SDL_BUTTON_LEFT;
+    e.button.state = type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+    e.button.x = x;
+    e.button.y = y;
+    return e;
+}
+
+// Walks the robot down past the doors' row, which scrolls the camera
+// 62 px, then right into the puzzle door's reach, and clicks the door
+// where it now is on screen. Against an unscrolled camera that click
+// lands above the door.
+static bool recordDoorSession(const std::string& path) {
+    InputRecorder recorder;
+    if (!recorder.open(path, BENCH_SEED)) return false;
+
+    auto frame = [&recorder](std::initializer_list<SDL_Event> events) {
+        recorder.beginFrame(FRAME_SECONDS);
+        for (const SDL_Event& e : events) recorder.record(e);
+        recorder.endFrame();
+    };
+    auto press = [&frame](SDL_Keycode sym) { frame({keyEvent(SDL_KEYDOWN, sym), keyEvent(SDL_KEYUP, sym)}); };
+
+    for (int i = 0; i < 23; ++i) press(SDLK_DOWN);   // y 100 -> 330
+    for (int i = 0; i < 17; ++i) press(SDLK_RIGHT);  // x 50 -> 220
+    for (int i = 0; i < 5; ++i) frame({});
+    frame({buttonEvent(SDL_MOUSEBUTTONDOWN, 250, 60), buttonEvent(SDL_MOUSEBUTTONUP, 250, 60)});
+    for (int i = 0; i < 5; ++i) frame({});
+    recorder.close();
+    return true;
+}
+
+// Plays the recording on floor 1 the way GameManager does; true once a
+// door puts a scene over the floor
+static bool replayOpensDoor(GameContext& ctx, const std::string& path, bool render) {
+    InputReplay replay;
+    if (!replay.open(path)) return false;
+    RngService::instance().seed(replay.seed());
+    InputState::instance().reset();
+
+    SceneStack stack;
+    stack.push(createFloor1Scene(ctx));
+    stack.applyPending();
+    Scene* floor = stack.top();
+
+    FrameScheduler frame;
+    double seconds = 0.0;
+    std::vector<SDL_Event> events;
+    while (replay.nextFrame(seconds, events)) {
+        frame.beginFrame(seconds);
+        for (const SDL_Event& e : events) {
+            InputState::instance().handleEvent(e);
+            stack.handleEvent(e);
+        }
+        while (frame.step()) stack.update(frame.stepSeconds());
+        if (render) {
+            stack.render(ctx.renderer, frame.alpha());
+            SDL_RenderPresent(ctx.renderer);
+        }
+        stack.applyPending();
+        if (stack.top() != floor) return true;
+    }
+    return false;
+}
+
+static int runReplayCheck() {
+    GameContext ctx;
+    ctx.playerName = "bench";
+    if (!initSDL(ctx)) return 1;
+
+    const std::string path = "replay_check.errp";
+    bool recorded = recordDoorSession(path);
+    bool rendered = recorded && replayOpensDoor(ctx, path, true);
+    bool fast = recorded && replayOpensDoor(ctx, path, false);
+    std::remove(path.c_str());
+    shutdownSDL(ctx);
+
+    if (!recorded) {
+        std::cerr << "replay check: cannot write " << path << std::endl;
+        return 1;
+    }
+    std::printf("replay check: door %s when rendered, %s with --fast\n",
+                rendered ? "opened" : "did not open", fast ? "opened" : "did not open");
+    return rendered && fast ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = DEFAULT_FRAMES;
+    std::string only;
+    std::vector<Scenario> all = scenarios();
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--only") == 0 && i + 1 < argc) only = argv[++i];
+        else if (std::strcmp(argv[i], "--replay-check") == 0) return runReplayCheck();
+        else if (std::strcmp(argv[i], "--list") == 0) {
+            for (const Scenario& s : all) std::printf("%s\n", s.name);
+            return 0;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [--only <scenario>] [--list] | --replay-check\n";
+            return 2;
+        }
+    }
+
+    std::printf("%-14s %9s %9s %9s %9s %10s %8s %12s\n",
+                "scenario", "fps", "p50_ms", "p99_ms", "max_ms", "enter_ms", "restarts", "peak_rss_kb");
+    std::fflush(stdout);
+
+    int failures = 0;
+    bool matched = false;
+    for (const Scenario& scenario : all) {
+        if (!only.empty() && only != scenario.name) continue;
+        matched = true;
+
+        pid_t child = fork();
+        if (child < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        if (child == 0) _exit(runScenario(scenario, frames));
+
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::printf("%-14s FAILED\n", scenario.name);
+            ++failures;
+        }
+    }
+
+    if (!matched) {
+        std::cerr << "Unknown scenario: " << only << "\n";
+        return 2;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+// tools/run_log_bench.cpp
+// Benchmark for RunLog at leaderboard sizes the game will never see:
+// imports a legacy leaderboard.txt of N runs, reloads the snapshot, then
+// records runs one at a time with and without fsync.
+//
+// Usage: run-log-bench [--runs N] [--appends N] [--synced N]
+// Works in a fresh directory under /tmp, which it removes afterwards.
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../common/run_log.h"
+#include "../common/rng.h"
+
+static const int DEFAULT_RUNS = 1000000;
+static const int DEFAULT_APPENDS = 20000;
+static const int DEFAULT_SYNCED = 50;
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return long(usage.ru_maxrss);
+}
+
+static void report(const char* what, double totalMs, int operations) {
+    std::printf("%-22s %12.1f %12.3f\n", what, totalMs, operations > 0 ? totalMs * 1000.0 / operations : 0.0);
+}
+
+// Per-append latencies: mean plus the tail, where compactions land
+static void reportAppends(const char* what, std::vector<double>& micros) {
+    if (micros.empty()) return;
+    double total = 0.0;
+    for (double us : micros) total += us;
+    std::sort(micros.begin(), micros.end());
+    std::printf("%-22s %12.1f %12.3f   p99 %.1f us, max %.1f ms\n", what, total / 1000.0, total / micros.size(),
+                micros[size_t(0.99 * (micros.size() - 1))], micros.back() / 1000.0);
+}
+
+int main(int argc, char* argv[]) {
+    int runs = DEFAULT_RUNS, appends = DEFAULT_APPENDS, synced = DEFAULT_SYNCED;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--appends") == 0 && i + 1 < argc) appends = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--synced") == 0 && i + 1 < argc) synced = std::max(0, std::atoi(argv[++i]));
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--runs N] [--appends N] [--synced N]\n";
+            return 2;
+        }
+    }
+
+    char directory[] = "/tmp/run_log_bench.XXXXXX";
+    if (!mkdtemp(directory)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    const std::string base = std::string(directory) + "/runs";
+    const std::string legacy = std::string(directory) + "/leaderboard.txt";
+
+    Rng rng(1);
+    {
+        std::ofstream out(legacy);
+        for (int i = 0; i < runs; ++i) out << "runner" << i << "," << rng.uniform(60.0f, 6000.0f) << "\n";
+    }
+
+    RunLog& log = RunLog::instance();
+    std::printf("%-22s %12s %12s\n", "phase", "total_ms", "per_op_us");
+
+    Clock::time_point start = Clock::now();
+    log.open(base, legacy);
+    report("import+compact", msSince(start), runs);
+
+    start = Clock::now();
+    log.open(base, legacy);
+    report("load snapshot", msSince(start), int(log.size()));
+
+    start = Clock::now();
+    std::vector<RunRecord> best = log.top();
+    report("top", msSince(start), 1);
+
+    log.setSyncOnAppend(false);
+    std::vector<double> micros;
+    micros.reserve(appends);
+    for (int i = 0; i < appends; ++i) {
+        float seconds = rng.uniform(60.0f, 6000.0f);
+        start = Clock::now();
+        log.append("bench", seconds);
+        micros.push_back(msSince(start) * 1000.0);
+    }
+    reportAppends("append", micros);
+
+    log.setSyncOnAppend(true);
+    micros.clear();
+    for (int i = 0; i < synced; ++i) {
+        float seconds = rng.uniform(60.0f, 6000.0f);
+        start = Clock::now();
+        log.append("bench", seconds);
+        micros.push_back(msSince(start) * 1000.0);
+    }
+    reportAppends("append+fsync", micros);
+
+    start = Clock::now();
+    size_t total = log.sortedRuns().size();
+    report("sort new runs in", msSince(start), 1);
+
+    start = Clock::now();
+    log.open(base, legacy);
+    report("reload snapshot+log", msSince(start), int(log.size()));
+
+    std::printf("runs %zu, fastest %.2f s, peak_rss_kb %ld\n", total, best.empty() ? 0.0 : best[0].seconds, peakRssKb());
+
+    std::remove(legacy.c_str());
+    std::remove((base + ".dat").c_str());
+    std::remove((base + ".log").c_str());
+    rmdir(directory);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// tools/tile_cutter.cpp
+// Cuts a floor background into TILE_SIZE squares for TiledBackground:
+// writes <dir>/<row>_<col>.png and <dir>/tiles.txt.
+//
+// Usage: tile_cutter [--tile-size N] <image.png> <dir>
+// The directory must exist; `make tiles` creates it.
+#include "tile_layout.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    TileManifest manifest;
+    int arg = 1;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--tile-size") == 0) {
+        manifest.tileSize = std::atoi(argv[arg + 1]);
+        arg += 2;
+    }
+    if (argc - arg != 2 || manifest.tileSize <= 0) {
+        std::cerr << "Usage: tile_cutter [--tile-size N] <image.png> <dir>" << std::endl;
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0 || IMG_Init(IMG_INIT_PNG) == 0) {
+        std::cerr << "SDL/SDL_image Initialization failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    std::string image = argv[arg], dir = argv[arg + 1];
+    SDL_Surface* loaded = IMG_Load(image.c_str());
+    SDL_Surface* source = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+    if (loaded) SDL_FreeSurface(loaded);
+    if (!source) {
+        std::cerr << "Could not load " << image << ": " << IMG_GetError() << std::endl;
+        return 1;
+    }
+    // Copy pixels as they are, alpha included
+    SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+
+    manifest.width = source->w;
+    manifest.height = source->h;
+
+    int status = 0;
+    for (int row = 0; row < manifest.rows() && status == 0; ++row) {
+        for (int col = 0; col < manifest.cols() && status == 0; ++col) {
+            SDL_Rect src = {col * manifest.tileSize, row * manifest.tileSize, manifest.tileSize, manifest.tileSize};
+            if (src.x + src.w > source->w) src.w = source->w - src.x;
+            if (src.y + src.h > source->h) src.h = source->h - src.y;
+
+            SDL_Surface* tile = SDL_CreateRGBSurfaceWithFormat(0, src.w, src.h, 32, SDL_PIXELFORMAT_ARGB8888);
+            std::string path = tilePath(dir, row, col);
+            if (!tile || SDL_BlitSurface(source, &src, tile, nullptr) != 0 || IMG_SavePNG(tile, path.c_str()) != 0) {
+                std::cerr << "Could not write " << path << ": " << SDL_GetError() << std::endl;
+                status = 1;
+            }
+            if (tile) SDL_FreeSurface(tile);
+        }
+    }
+
+    // The manifest goes last, so an interrupted run is never taken as complete
+    if (status == 0 && !writeTileManifest(dir, manifest)) {
+        std::cerr << "Could not write " << tileManifestPath(dir) << std::endl;
+        status = 1;
+    }
+    if (status == 0) {
+        std::cout << image << ": " << manifest.cols() << "x" << manifest.rows() << " tiles of "
+                  << manifest.tileSize << " px" << std::endl;
+    }
+
+    SDL_FreeSurface(source);
+    IMG_Quit();
+    SDL_Quit();
+    return status;
+}